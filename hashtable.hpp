@@ -2,7 +2,10 @@
 
 #include "include/chained.hpp"
 #include "include/cuckoo.hpp"
+#include "include/growing.hpp"
 #include "include/probing.hpp"
+#include "include/reduction.hpp"
+#include "include/sharded.hpp"
 
 // Order is important
 #include "include/convenience/undef.hpp"
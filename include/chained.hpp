@@ -1,26 +1,35 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 #include <map>
 #include <memory>
+#include <new>
 #include <optional>
 #include <string>
 #include <vector>
 
+#include <sys/mman.h>
+
+#include "directory.hpp"
+#include "reduction.hpp"
+#include "stats.hpp"
+
 // Order important
 #include "convenience/builtins.hpp"
 
 namespace hashtable {
    template<class Key, class Payload, size_t BucketSize, class HashFn, class ReductionFn,
-            Key Sentinel = std::numeric_limits<Key>::max()>
+            class StatsMode = NoStats, Key Sentinel = std::numeric_limits<Key>::max()>
    struct Chained {
      public:
       using KeyType = Key;
       using PayloadType = Payload;
 
-     private:
+     protected:
       const HashFn hashfn;
       const ReductionFn reductionfn;
       const size_t capacity;
@@ -53,44 +62,272 @@ namespace hashtable {
          if (slot.key == Sentinel) {
             slot.key = key;
             slot.payload = payload;
+            if constexpr (StatsMode::enabled) {
+               stored_count++;
+               occupied_slot_count++;
+            }
             return true;
          }
 
+         // key already exists
+         if (slot.key == key)
+            return false;
+
          // Initialize bucket chain if empty
-         Bucket* bucket = slot.buckets;
-         if (bucket == nullptr) {
-            auto b = new Bucket();
-            b->slots[0] = {.key = key, .payload = payload};
+         std::uint32_t bucket_index = slot.buckets;
+         if (bucket_index == NoBucket) {
+            const auto b = arena.allocate();
+            arena[b].slots[0] = {.key = key, .payload = payload};
             slot.buckets = b;
+            if constexpr (StatsMode::enabled) {
+               stored_count++;
+               chain_bucket_count++;
+               max_chain_length_ = std::max(max_chain_length_, static_cast<size_t>(1));
+            }
             return true;
          }
 
          // Go through existing buckets and try to insert there if possible
+         size_t chain_length = 1;
          for (;;) {
-            // Find suitable empty entry place. Note that deletions with holes will require
-            // searching entire bucket to deal with duplicate keys!
+            Bucket& bucket = arena[bucket_index];
+
+            // Find suitable empty entry place. Note that erase() fills holes
+            // immediately, i.e., the first empty slot terminates the chain's
+            // occupied region and the duplicate check may stop there.
             for (size_t i = 0; i < BucketSize; i++) {
-               if (bucket->slots[i].key == Sentinel) {
-                  bucket->slots[i] = {.key = key, .payload = payload};
+               if (bucket.slots[i].key == Sentinel) {
+                  bucket.slots[i] = {.key = key, .payload = payload};
+                  if constexpr (StatsMode::enabled)
+                     stored_count++;
                   return true;
-               } else if (bucket->slots[i].key == key) {
+               } else if (bucket.slots[i].key == key) {
                   // key already exists
                   return false;
                }
             }
 
-            if (bucket->next == nullptr)
+            if (bucket.next == NoBucket)
                break;
-            bucket = bucket->next;
+            bucket_index = bucket.next;
+            chain_length++;
          }
 
          // Append a new bucket to the chain and add element there
-         auto b = new Bucket();
-         b->slots[0] = {.key = key, .payload = payload};
-         bucket->next = b;
+         const auto b = arena.allocate();
+         arena[b].slots[0] = {.key = key, .payload = payload};
+         arena[bucket_index].next = b;
+         if constexpr (StatsMode::enabled) {
+            stored_count++;
+            chain_bucket_count++;
+            max_chain_length_ = std::max(max_chain_length_, chain_length + 1);
+         }
          return true;
       }
 
+      /**
+       * Bulk inserts a sorted key range, sweeping the directory sequentially
+       * instead of performing one random access per key.
+       *
+       * Since a monotone hash function maps sorted keys to non decreasing
+       * slot indices, the target slot of each key is either the one the
+       * previous key went to (cursor cached, no chain walk) or a later one
+       * (sequential directory access, hardware prefetcher friendly). Should
+       * the hash function not be monotone after all, affected keys gracefully
+       * fall back to regular insert().
+       *
+       * NOTE: keys must be sorted and deduplicated. Duplicates relative to
+       * previously inserted table contents are not detected.
+       *
+       * @param keys_begin iterator to the first key
+       * @param keys_end past-the-end key iterator
+       * @param payloads_begin iterator to the payload of the first key
+       * @return amount of keys that were inserted
+       */
+      template<class KeyIt, class PayloadIt>
+      size_t bulk_insert(KeyIt keys_begin, KeyIt keys_end, PayloadIt payloads_begin) {
+         size_t inserted = 0;
+
+         bool slot_active = false;
+         size_t current_index = 0;
+         std::uint32_t tail = NoBucket; // last bucket of the active slot's chain (if any)
+         size_t tail_fill = 0; // amount of occupied entries in tail
+         size_t chain_length = 0; // amount of buckets in the active slot's chain
+
+         auto payload_it = payloads_begin;
+         for (auto key_it = keys_begin; key_it != keys_end; ++key_it, ++payload_it) {
+            const Key key = *key_it;
+            const Payload payload = *payload_it;
+
+            if (unlikely(key == Sentinel)) {
+               assert(false); // TODO(unknown): this must never happen in practice
+               continue;
+            }
+
+            const auto slot_index = reductionfn(hashfn(key));
+
+            // non monotone hash order violation -> regular insert
+            if (unlikely(slot_active && slot_index < current_index)) {
+               inserted += insert(key, payload) ? 1 : 0;
+               continue;
+            }
+
+            if (!slot_active || slot_index != current_index) {
+               // position the cursor at the end of the (usually empty) chain
+               current_index = slot_index;
+               slot_active = true;
+               tail = slots[slot_index].buckets;
+               tail_fill = 0;
+               chain_length = tail != NoBucket ? 1 : 0;
+               if (tail != NoBucket) {
+                  while (arena[tail].next != NoBucket) {
+                     tail = arena[tail].next;
+                     chain_length++;
+                  }
+                  while (tail_fill < BucketSize && arena[tail].slots[tail_fill].key != Sentinel)
+                     tail_fill++;
+               }
+            }
+
+            FirstLevelSlot& slot = slots[current_index];
+
+            // Store directly in slot if possible
+            if (slot.key == Sentinel) {
+               slot.key = key;
+               slot.payload = payload;
+               inserted++;
+               if constexpr (StatsMode::enabled) {
+                  stored_count++;
+                  occupied_slot_count++;
+               }
+               continue;
+            }
+
+            // key already exists
+            if (unlikely(slot.key == key))
+               continue;
+
+            // Append to the slot's chain, allocating a fresh tail bucket if needed
+            if (tail == NoBucket) {
+               tail = arena.allocate();
+               slot.buckets = tail;
+               tail_fill = 0;
+               chain_length = 1;
+               if constexpr (StatsMode::enabled)
+                  chain_bucket_count++;
+            } else if (tail_fill == BucketSize) {
+               const auto b = arena.allocate();
+               arena[tail].next = b;
+               tail = b;
+               tail_fill = 0;
+               chain_length++;
+               if constexpr (StatsMode::enabled)
+                  chain_bucket_count++;
+            }
+
+            arena[tail].slots[tail_fill++] = {.key = key, .payload = payload};
+            inserted++;
+            if constexpr (StatsMode::enabled) {
+               stored_count++;
+               max_chain_length_ = std::max(max_chain_length_, chain_length);
+            }
+         }
+
+         return inserted;
+      }
+
+      /**
+       * Removes a key from the hashtable.
+       *
+       * The hole left behind is immediately filled with the chain's last
+       * element, i.e., chains stay densely packed and lookup's early exit on
+       * the first empty slot remains correct. Emptied tail buckets are
+       * unlinked but only reclaimed by the arena on the next clear().
+       *
+       * @param key
+       * @return whether or not the key was present and removed
+       */
+      bool erase(const Key& key) {
+         if (unlikely(key == Sentinel)) {
+            assert(false); // TODO(unknown): this must never happen in practice
+            return false;
+         }
+
+         FirstLevelSlot& slot = slots[reductionfn(hashfn(key))];
+         if (slot.key == Sentinel)
+            return false;
+
+         // locate the chain's last element and the tail bucket's predecessor
+         std::uint32_t tail = slot.buckets;
+         std::uint32_t before_tail = NoBucket;
+         size_t tail_fill = 0;
+         if (tail != NoBucket) {
+            while (arena[tail].next != NoBucket) {
+               before_tail = tail;
+               tail = arena[tail].next;
+            }
+            while (tail_fill < BucketSize && arena[tail].slots[tail_fill].key != Sentinel)
+               tail_fill++;
+         }
+
+         const auto unlink_empty_tail = [&]() {
+            if (--tail_fill > 0)
+               return;
+            if (before_tail == NoBucket)
+               slot.buckets = NoBucket;
+            else
+               arena[before_tail].next = NoBucket;
+            if constexpr (StatsMode::enabled)
+               chain_bucket_count--;
+         };
+
+         if (slot.key == key) {
+            if (tail == NoBucket) {
+               slot.key = Sentinel;
+               if constexpr (StatsMode::enabled) {
+                  stored_count--;
+                  occupied_slot_count--;
+               }
+               return true;
+            }
+
+            // fill the hole with the chain's last element
+            Bucket& tail_bucket = arena[tail];
+            slot.key = tail_bucket.slots[tail_fill - 1].key;
+            slot.payload = tail_bucket.slots[tail_fill - 1].payload;
+            tail_bucket.slots[tail_fill - 1].key = Sentinel;
+            unlink_empty_tail();
+            if constexpr (StatsMode::enabled)
+               stored_count--;
+            return true;
+         }
+
+         for (std::uint32_t bucket_index = slot.buckets; bucket_index != NoBucket;
+              bucket_index = arena[bucket_index].next) {
+            Bucket& bucket = arena[bucket_index];
+            for (size_t i = 0; i < BucketSize; i++) {
+               if (bucket.slots[i].key == key) {
+                  // fill the hole with the chain's last element (unless the
+                  // erased entry is the last element itself)
+                  if (bucket_index != tail || i + 1 != tail_fill) {
+                     bucket.slots[i].key = arena[tail].slots[tail_fill - 1].key;
+                     bucket.slots[i].payload = arena[tail].slots[tail_fill - 1].payload;
+                  }
+                  arena[tail].slots[tail_fill - 1].key = Sentinel;
+                  unlink_empty_tail();
+                  if constexpr (StatsMode::enabled)
+                     stored_count--;
+                  return true;
+               }
+
+               if (bucket.slots[i].key == Sentinel)
+                  return false;
+            }
+         }
+
+         return false;
+      }
+
       /**
        * Retrieves the associated payload/value for a given key.
        *
@@ -105,70 +342,195 @@ namespace hashtable {
 
          // Using template functor should successfully inline actual hash computation
          const FirstLevelSlot& slot = slots[reductionfn(hashfn(key))];
+         return lookup_slot(slot, key);
+      }
 
-         if (slot.key == key) {
-            return std::make_optional(slot.payload);
+      /**
+       * Retrieves the payloads for a batch of keys at once, overlapping the
+       * directory cache misses of the individual lookups: all hashes of a
+       * group are computed and their target slots prefetched before the first
+       * probe is resolved.
+       *
+       * Entries of out corresponding to keys that are not in the hashtable
+       * are left untouched.
+       *
+       * @param keys pointer to the first key of the batch
+       * @param n batch size
+       * @param out result array, n entries
+       * @return amount of keys that were found
+       */
+      size_t lookup_batch(const Key* keys, const size_t n, Payload* out) const {
+         constexpr size_t group_size = 16;
+         size_t slot_indices[group_size];
+         size_t found = 0;
+
+         for (size_t base = 0; base < n; base += group_size) {
+            const size_t group = std::min(group_size, n - base);
+
+            for (size_t j = 0; j < group; j++) {
+               slot_indices[j] = reductionfn(hashfn(keys[base + j]));
+               prefetch(&slots[slot_indices[j]], 0, 1);
+            }
+
+            for (size_t j = 0; j < group; j++) {
+               if (const auto payload = lookup_slot(slots[slot_indices[j]], keys[base + j])) {
+                  out[base + j] = payload.value();
+                  found++;
+               }
+            }
          }
 
-         Bucket* bucket = slot.buckets;
-         while (bucket != nullptr) {
-            for (size_t i = 0; i < BucketSize; i++) {
-               if (bucket->slots[i].key == key) {
-                  Payload payload = bucket->slots[i].payload;
-                  return std::make_optional(payload);
+         return found;
+      }
+
+      /**
+       * Retrieves the payloads for a batch of keys with AMAC-style software
+       * pipelining (asynchronous memory access chaining): up to InFlight
+       * lookup state machines are live at any time, each suspending right
+       * after issuing the prefetch for its next pointer hop (first level
+       * slot resp. Bucket::next) while the others advance, i.e., the
+       * dependent loads of a chain walk are hidden behind independent work
+       * instead of stalling the core.
+       *
+       * Entries of out corresponding to keys that are not in the hashtable
+       * are left untouched.
+       *
+       * @param keys pointer to the first key of the batch
+       * @param n batch size
+       * @param out result array, n entries
+       * @return amount of keys that were found
+       */
+      template<size_t InFlight = 16>
+      size_t lookup_interleaved(const Key* keys, const size_t n, Payload* out) const {
+         struct Probe {
+            size_t key_index;
+            size_t slot_index;
+            std::uint32_t bucket; // NoBucket while the first level slot is pending
+         };
+
+         Probe probes[InFlight];
+         size_t active = 0; // probes[0..active) are in flight
+         size_t next_key = 0;
+         size_t found = 0;
+
+         const auto admit = [&](Probe& probe) {
+            probe.key_index = next_key++;
+            probe.slot_index = reductionfn(hashfn(keys[probe.key_index]));
+            probe.bucket = NoBucket;
+            prefetch(&slots[probe.slot_index], 0, 1);
+         };
+
+         while (active < InFlight && next_key < n)
+            admit(probes[active++]);
+
+         size_t cursor = 0;
+         while (active > 0) {
+            if (cursor >= active)
+               cursor = 0;
+            auto& probe = probes[cursor];
+
+            const Key key = keys[probe.key_index];
+            bool done = false;
+            if (probe.bucket == NoBucket) {
+               // first level slot is (by now hopefully) cache resident
+               const FirstLevelSlot& slot = slots[probe.slot_index];
+               if (slot.key == key) {
+                  out[probe.key_index] = slot.payload;
+                  found++;
+                  done = true;
+               } else if (slot.buckets == NoBucket) {
+                  done = true;
+               } else {
+                  probe.bucket = slot.buckets;
                }
+            } else {
+               // resolve exactly one chain bucket
+               const Bucket& bucket = arena[probe.bucket];
+               done = true;
+               for (size_t i = 0; i < BucketSize; i++) {
+                  const Key k = bucket.slots[i].key;
+                  if (k == key) {
+                     out[probe.key_index] = bucket.slots[i].payload;
+                     found++;
+                     break;
+                  }
 
-               if (bucket->slots[i].key == Sentinel)
-                  return std::nullopt;
+                  // first empty slot terminates the chain's occupied region
+                  if (k == Sentinel)
+                     break;
+
+                  if (i + 1 == BucketSize && bucket.next != NoBucket) {
+                     probe.bucket = bucket.next;
+                     done = false;
+                  }
+               }
+            }
+
+            if (!done) {
+               // suspend: prefetch the next hop, switch to another probe
+               prefetch(&arena[probe.bucket], 0, 1);
+               cursor++;
+               continue;
+            }
+
+            // retire: hand this state machine the next key (if any)
+            if (next_key < n) {
+               admit(probe);
+               cursor++;
+            } else {
+               probe = probes[--active];
             }
-            bucket = bucket->next;
          }
 
-         return std::nullopt;
+         return found;
       }
 
       /**
-       * Retrieves the payloads associated with keys within [min, max].
+       * Invokes visit(key, payload) for every entry with a key within
+       * [min, max], without materializing any result buffer, i.e., wide
+       * analytical scans can aggregate in place with zero heap allocation.
        *
        * NOTE: this function will only return sensible results if the employed
        * hash function is monotone
        *
        * @param min minimum key value (inclusive)
        * @param max maximum key value (inclusive)
-       * @return a vector of payloads associated with keys within the range, if
-       *   any exist. Otherwise empty.
+       * @param visit functor invoked once per matching (key, payload) pair
        */
-      std::vector<Payload> lookup_range(const Key& min, const Key& max) {
+      template<class F>
+      void lookup_range(const Key& min, const Key& max, F&& visit) const {
          if (unlikely(min == Sentinel || max == Sentinel)) {
             assert(false); // TODO(dominik): this must never happen in practice
-            return {};
+            return;
          }
 
          // min will be in this slot or a subsequent slot
          const auto lower_bound_index = reductionfn(hashfn(min));
 
-         // edge case: we've got an exact inline match
-         std::vector<Payload> result;
-
          // loop variables
          auto i = lower_bound_index;
          bool continue_until_next_slot = true;
          for (; i<slots.size() && continue_until_next_slot; i++) {
             // get the current slot
-            auto& current_slot = slots[i];
-            // start from the current slot
-            if (current_slot.key >= min && current_slot.key <= max)
-               result.push_back(current_slot.payload);
-            if (current_slot.key >= max && current_slot.key != Sentinel)
+            const auto& current_slot = slots[i];
+            // start from the current slot (copy out of the packed slot
+            // before binding any reference)
+            const Key slot_key = current_slot.key;
+            if (slot_key >= min && slot_key <= max) {
+               const Payload payload = current_slot.payload;
+               visit(slot_key, payload);
+            }
+            if (slot_key >= max && slot_key != Sentinel)
                continue_until_next_slot = false;
             // now, proceed with the buckets
-            Bucket* bucket = current_slot.buckets;
-            while (bucket != nullptr) {
-               for (size_t i = 0; i < BucketSize; i++) {
-                  Key k = bucket->slots[i].key;
+            std::uint32_t bucket_index = current_slot.buckets;
+            while (bucket_index != NoBucket) {
+               const Bucket& bucket = arena[bucket_index];
+               for (size_t j = 0; j < BucketSize; j++) {
+                  const Key k = bucket.slots[j].key;
                   if (k >= min && k <= max) {
-                     // add payload to result
-                     result.push_back(bucket->slots[i].payload);
+                     const Payload payload = bucket.slots[j].payload;
+                     visit(k, payload);
                   }
                   // if we encounter something >= max in the bucket chain, we don't need to continue
                   if (k >= max && k != Sentinel)
@@ -177,15 +539,94 @@ namespace hashtable {
                   if (k == Sentinel)
                      break;
                }
-               bucket = bucket->next;
+               bucket_index = bucket.next;
             }
          }
+      }
+
+      /**
+       * Retrieves the payloads associated with keys within [min, max].
+       *
+       * NOTE: this function will only return sensible results if the employed
+       * hash function is monotone
+       *
+       * @param min minimum key value (inclusive)
+       * @param max maximum key value (inclusive)
+       * @return a vector of payloads associated with keys within the range, if
+       *   any exist. Otherwise empty.
+       */
+      std::vector<Payload> lookup_range(const Key& min, const Key& max) const {
+         std::vector<Payload> result;
+         lookup_range(min, max, [&](const Key&, const Payload& payload) { result.push_back(payload); });
          return result;
       }
 
+      /**
+       * Amount of entries with a key within [min, max], skipping payload
+       * materialization entirely.
+       *
+       * NOTE: this function will only return sensible results if the employed
+       * hash function is monotone
+       *
+       * @param min minimum key value (inclusive)
+       * @param max maximum key value (inclusive)
+       */
+      size_t count_range(const Key& min, const Key& max) const {
+         size_t count = 0;
+         lookup_range(min, max, [&](const Key&, const Payload&) { count++; });
+         return count;
+      }
+
+      /**
+       * Invokes f(key, payload) for every entry stored in the directory slot
+       * range [from, from + n), including overflow chains, e.g., to migrate
+       * entries during an incremental resize (see Growing).
+       */
+      template<class F>
+      void for_each_in_buckets(const size_t& from, const size_t& n, F f) const {
+         for (size_t s = from; s < from + n; s++) {
+            const auto& slot = slots[s];
+
+            // an empty first level slot cannot have a chain
+            if (slot.key == Sentinel)
+               continue;
+
+            {
+               // copy from the packed fields before binding references
+               const Key key = slot.key;
+               const Payload payload = slot.payload;
+               f(key, payload);
+            }
+
+            for (std::uint32_t bucket_index = slot.buckets; bucket_index != NoBucket;
+                 bucket_index = arena[bucket_index].next) {
+               const Bucket& bucket = arena[bucket_index];
+               for (size_t i = 0; i < BucketSize; i++) {
+                  const Key key = bucket.slots[i].key;
+                  // the first empty slot terminates the chain's occupied region
+                  if (key == Sentinel)
+                     break;
+
+                  const Payload payload = bucket.slots[i].payload;
+                  f(key, payload);
+               }
+            }
+         }
+      }
+
       std::map<std::string, double> lookup_statistics(const std::vector<Key>& dataset) {
          UNUSED(dataset);
 
+         if constexpr (StatsMode::enabled) {
+            // O(1) read of the incrementally maintained counters. Note that
+            // max_chain_length is a high water mark, i.e., erase() does not
+            // lower it
+            return {{"stored", stored_count},
+                    {"empty_buckets", slots.size() - occupied_slot_count},
+                    {"additional_buckets", chain_bucket_count},
+                    {"max_chain_length", max_chain_length_}};
+         }
+
          size_t max_chain_length = 0;
          size_t min_chain_length = std::numeric_limits<size_t>::max();
          size_t empty_buckets = 0;
@@ -199,15 +640,15 @@ namespace hashtable {
             }
 
             size_t chain_length = 0;
-            Bucket* b = slot.buckets;
-            while (b != nullptr) {
+            std::uint32_t b = slot.buckets;
+            while (b != NoBucket) {
                chain_length++;
                additional_buckets++;
 
-               for (const auto& s : b->slots)
+               for (const auto& s : arena[b].slots)
                   empty_additional_slots += s.key == Sentinel ? 1 : 0;
 
-               b = b->next;
+               b = arena[b].next;
             }
 
             min_chain_length = std::min(min_chain_length, chain_length);
@@ -222,11 +663,7 @@ namespace hashtable {
       }
 
       size_t byte_size() const {
-         size_t size = sizeof(decltype(*this)) + slots.size() * slot_byte_size();
-         for (const auto& slot : slots)
-            size += slot.buckets == nullptr ? 0 : slot.buckets->byte_size();
-
-         return size;
+         return sizeof(decltype(*this)) + slots.byte_size() + arena.byte_size();
       }
 
       static constexpr forceinline size_t bucket_byte_size() {
@@ -238,7 +675,8 @@ namespace hashtable {
       }
 
       static forceinline std::string name() {
-         return "chained_" + hash_name() + "_" + reducer_name() + "_" + std::to_string(bucket_size());
+         return "chained_" + hash_name() + "_" + reducer_name() + "_" + std::to_string(bucket_size()) +
+            (StatsMode::enabled ? "_" + StatsMode::name() : "");
       }
 
       static forceinline std::string hash_name() {
@@ -254,33 +692,43 @@ namespace hashtable {
       }
 
       static constexpr forceinline size_t directory_address_count(const size_t& capacity) {
+         // power of two directory mode, see requires_pow2_directory
+         if constexpr (requires_pow2_directory<ReductionFn>::value)
+            return next_pow2(capacity);
          return capacity;
       }
 
       /**
        * Clears all keys from the hashtable. Note that payloads are technically
        * still in memory (i.e., might leak if sensitive).
+       *
+       * Overflow buckets are not freed but bulk-recycled by the arena, i.e.,
+       * no chain is ever walked.
        */
       void clear() {
          for (auto& slot : slots) {
             slot.key = Sentinel;
+            slot.buckets = NoBucket;
+         }
 
-            auto bucket = slot.buckets;
-            slot.buckets = nullptr;
+         arena.reset();
 
-            while (bucket != nullptr) {
-               auto next = bucket->next;
-               delete bucket;
-               bucket = next;
-            }
+         if constexpr (StatsMode::enabled) {
+            stored_count = 0;
+            occupied_slot_count = 0;
+            chain_bucket_count = 0;
+            max_chain_length_ = 0;
          }
       }
 
-      ~Chained() {
-         clear();
-      }
-
      protected:
+      /// marks the end of a chain resp. an empty chain (no overflow buckets)
+      static constexpr std::uint32_t NoBucket = std::numeric_limits<std::uint32_t>::max();
+
+      // Buckets reference each other via 32 bit arena indices rather than raw
+      // pointers, halving the link overhead per bucket and first level slot.
+      // Indices are also position independent, i.e., they survive relocation
+      // of the arena's storage (snapshot friendly).
       struct Bucket {
          struct Slot {
             Key key = Sentinel;
@@ -288,20 +736,368 @@ namespace hashtable {
          } packit;
 
          std::array<Slot, BucketSize> slots /*__attribute((aligned(sizeof(Key) * 8)))*/;
-         Bucket* next = nullptr;
-
-         size_t byte_size() const {
-            return sizeof(decltype(*this)) + (next == nullptr ? 0 : next->byte_size());
-         }
+         std::uint32_t next = NoBucket;
       } packit;
 
       struct FirstLevelSlot {
          Key key = Sentinel;
          Payload payload;
-         Bucket* buckets = nullptr;
+         std::uint32_t buckets = NoBucket;
       } packit;
 
+      /**
+       * Resolves a lookup within an already located first level slot,
+       * walking its overflow chain if necessary.
+       */
+      forceinline std::optional<Payload> lookup_slot(const FirstLevelSlot& slot, const Key& key) const {
+         if (slot.key == key) {
+            return std::make_optional(slot.payload);
+         }
+
+         std::uint32_t bucket_index = slot.buckets;
+         while (bucket_index != NoBucket) {
+            const Bucket& bucket = arena[bucket_index];
+            if constexpr (BucketSize == 1) {
+               // single slot fast path: one load feeding two compares, no
+               // inner loop bookkeeping
+               const Key k = bucket.slots[0].key;
+               if (k == key)
+                  return std::make_optional(bucket.slots[0].payload);
+               if (k == Sentinel)
+                  return std::nullopt;
+            } else if constexpr (BucketSize <= 8) {
+               // fully unrolled branch free compare chain: resolve all slots
+               // before branching once. Chains fill front to back, i.e., no
+               // entry ever sits behind an empty slot of the same bucket and
+               // the empty check may be deferred past the matches
+               size_t match_i = BucketSize;
+               size_t empty_i = BucketSize;
+               for (size_t i = BucketSize; i-- > 0;) {
+                  match_i = bucket.slots[i].key == key ? i : match_i;
+                  empty_i = bucket.slots[i].key == Sentinel ? i : empty_i;
+               }
+
+               if (match_i < BucketSize) {
+                  Payload payload = bucket.slots[match_i].payload;
+                  return std::make_optional(payload);
+               }
+               if (empty_i < BucketSize)
+                  return std::nullopt;
+            } else {
+               for (size_t i = 0; i < BucketSize; i++) {
+                  if (bucket.slots[i].key == key) {
+                     Payload payload = bucket.slots[i].payload;
+                     return std::make_optional(payload);
+                  }
+
+                  if (bucket.slots[i].key == Sentinel)
+                     return std::nullopt;
+               }
+            }
+            bucket_index = bucket.next;
+         }
+
+         return std::nullopt;
+      }
+
+
+      /**
+       * Slab allocator for overflow buckets, addressed via 32 bit indices.
+       * Buckets are carved out of large contiguous blocks, so buckets chained
+       * behind the same slot tend to be adjacent in memory and index to
+       * address translation is a single division by a compile time constant.
+       * reset() recycles all blocks at once without walking any chain; handed
+       * out buckets are lazily reinitialized on their next allocation.
+       */
+      class BucketArena {
+         /// amount of buckets per block. Chosen such that blocks are a few MB large
+         static constexpr size_t block_capacity = (4LLU << 20) / sizeof(Bucket);
+
+         /// highest amount of blocks the 32 bit index space can ever address
+         static constexpr size_t max_blocks = std::numeric_limits<std::uint32_t>::max() / block_capacity + 1;
+
+         /// bytes reserved per block when huge page backed
+         static constexpr size_t block_mapped_bytes = huge_pages::round_up(block_capacity * sizeof(Bucket));
+
+         std::vector<Bucket*> blocks;
+         size_t next_index = 0;
+
+         /// fixed at construction: all blocks of one arena share a single
+         /// allocation scheme, i.e., teardown needs no per block bookkeeping
+         const bool huge_blocks = huge_pages::enabled;
+
+         Bucket* allocate_block() const {
+            if (huge_blocks) {
+               void* mapping =
+                  mmap(nullptr, block_mapped_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+               if (unlikely(mapping == MAP_FAILED))
+                  throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+               madvise(mapping, block_mapped_bytes, MADV_HUGEPAGE);
+#endif
+               auto* block = static_cast<Bucket*>(mapping);
+               for (size_t i = 0; i < block_capacity; i++)
+                  new (block + i) Bucket();
+               return block;
+            }
+            return new Bucket[block_capacity];
+         }
+
+        public:
+         BucketArena() {
+            // never reallocate the block table. Readers index it without
+            // synchronization (see ConcurrentChained), and it tops out at a
+            // few hundred KB anyways
+            blocks.reserve(max_blocks);
+         }
+
+         BucketArena(BucketArena&&) noexcept = default;
+
+         forceinline std::uint32_t allocate() {
+            assert(next_index < std::numeric_limits<std::uint32_t>::max());
+            const size_t index = next_index++;
+            const size_t block = index / block_capacity;
+
+            if (unlikely(block == blocks.size()))
+               blocks.push_back(allocate_block());
+
+            Bucket& b = blocks[block][index % block_capacity];
+            b = Bucket(); // buckets might be recycled, i.e., always reinitialize
+            return static_cast<std::uint32_t>(index);
+         }
+
+         forceinline Bucket& operator[](const std::uint32_t& index) {
+            return blocks[index / block_capacity][index % block_capacity];
+         }
+
+         forceinline const Bucket& operator[](const std::uint32_t& index) const {
+            return blocks[index / block_capacity][index % block_capacity];
+         }
+
+         void reset() {
+            next_index = 0;
+         }
+
+         size_t byte_size() const {
+            return blocks.size() * (huge_blocks ? block_mapped_bytes : block_capacity * sizeof(Bucket));
+         }
+
+         ~BucketArena() {
+            for (auto* block : blocks) {
+               if (huge_blocks)
+                  munmap(block, block_mapped_bytes);
+               else
+                  delete[] block;
+            }
+         }
+      };
+
       // First bucket is always inline in the slot
-      std::vector<FirstLevelSlot> slots;
+      Directory<FirstLevelSlot> slots;
+
+      BucketArena arena;
+
+      /// incremental statistics, only maintained when StatsMode::enabled
+      /// (see lookup_statistics())
+      size_t stored_count = 0;
+      size_t occupied_slot_count = 0;
+      size_t chain_bucket_count = 0;
+      size_t max_chain_length_ = 0;
+   };
+
+   /**
+    * Chained hashtable whose insert may be called concurrently from many
+    * threads, e.g., to parallelize table builds or to ingest online.
+    *
+    * Writes are synchronized with striped spinlocks over the directory;
+    * overflow bucket allocations additionally serialize on the arena.
+    * lookup() takes the stripe lock as well and may therefore be freely
+    * interleaved with concurrent inserts. clear() is not thread safe.
+    */
+   template<class Key, class Payload, size_t BucketSize, class HashFn, class ReductionFn,
+            class StatsMode = NoStats, Key Sentinel = std::numeric_limits<Key>::max()>
+   struct ConcurrentChained : protected Chained<Key, Payload, BucketSize, HashFn, ReductionFn, StatsMode, Sentinel> {
+     private:
+      using Base = Chained<Key, Payload, BucketSize, HashFn, ReductionFn, StatsMode, Sentinel>;
+
+      // insert_locked would race on the table wide counters (the stripe
+      // locks only serialize per directory region)
+      static_assert(!StatsMode::enabled, "ConcurrentChained does not synchronize statistics counters, use NoStats");
+
+      class Spinlock {
+         std::atomic_flag flag; // value initialized to clear (since C++20)
+
+        public:
+         forceinline void lock() {
+            while (flag.test_and_set(std::memory_order_acquire)) {
+               // spin. Critical sections are a few cache accesses long, i.e.,
+               // yielding to the OS is not worth it
+            }
+         }
+
+         forceinline void unlock() {
+            flag.clear(std::memory_order_release);
+         }
+      };
+
+      /// must be a power of two (stripe index is computed via bitmask)
+      static constexpr size_t StripeCount = 1024;
+
+      std::vector<Spinlock> stripes;
+      Spinlock arena_lock;
+
+     public:
+      using KeyType = Key;
+      using PayloadType = Payload;
+
+      explicit ConcurrentChained(const size_t& capacity, const HashFn hashfn = HashFn())
+         : Base(capacity, hashfn), stripes(StripeCount) {}
+
+      ConcurrentChained(ConcurrentChained&&) noexcept = default;
+
+      using Base::byte_size;
+      using Base::clear;
+      using Base::count_range;
+      using Base::lookup_range;
+      using Base::lookup_statistics;
+
+      using Base::bucket_byte_size;
+      using Base::bucket_size;
+      using Base::directory_address_count;
+      using Base::hash_name;
+      using Base::reducer_name;
+      using Base::slot_byte_size;
+
+      /// capability marker: insert may be called from many threads (detected
+      /// by the benchmark harness to parallelize table builds)
+      static constexpr bool concurrent_inserts = true;
+
+      static forceinline std::string name() {
+         return "concurrent_" + Base::name();
+      }
+
+      /**
+       * Inserts a key, value/payload pair into the hashtable. Thread safe.
+       *
+       * @param key
+       * @param payload
+       * @return whether or not the key, payload pair was inserted. Insertion will fail
+       *    iff the same key already exists or if key == Sentinel value
+       */
+      bool insert(const Key& key, const Payload& payload) {
+         if (unlikely(key == Sentinel)) {
+            assert(false); // TODO(unknown): this must never happen in practice
+            return false;
+         }
+
+         const auto slot_index = this->reductionfn(this->hashfn(key));
+         Spinlock& stripe = stripes[slot_index & (StripeCount - 1)];
+
+         stripe.lock();
+         const bool inserted = insert_locked(slot_index, key, payload);
+         stripe.unlock();
+         return inserted;
+      }
+
+      /**
+       * Removes a key from the hashtable. Thread safe.
+       *
+       * @param key
+       * @return whether or not the key was present and removed
+       */
+      bool erase(const Key& key) {
+         if (unlikely(key == Sentinel)) {
+            assert(false); // TODO(unknown): this must never happen in practice
+            return false;
+         }
+
+         const auto slot_index = this->reductionfn(this->hashfn(key));
+         Spinlock& stripe = stripes[slot_index & (StripeCount - 1)];
+
+         stripe.lock();
+         const bool erased = Base::erase(key);
+         stripe.unlock();
+         return erased;
+      }
+
+      /**
+       * Retrieves the associated payload/value for a given key. Thread safe.
+       *
+       * @param key
+       * @return the payload or std::nullopt if key was not found in the Hashtable
+       */
+      std::optional<Payload> lookup(const Key& key) {
+         if (unlikely(key == Sentinel)) {
+            assert(false); // TODO(unknown): this must never happen in practice
+            return std::nullopt;
+         }
+
+         const auto slot_index = this->reductionfn(this->hashfn(key));
+         Spinlock& stripe = stripes[slot_index & (StripeCount - 1)];
+
+         stripe.lock();
+         const auto result = this->lookup_slot(this->slots[slot_index], key);
+         stripe.unlock();
+         return result;
+      }
+
+     private:
+      using Bucket = typename Base::Bucket;
+
+      forceinline std::uint32_t allocate_bucket() {
+         arena_lock.lock();
+         const std::uint32_t b = this->arena.allocate();
+         arena_lock.unlock();
+         return b;
+      }
+
+      /// insert logic, assumes the slot's stripe lock is held by the caller
+      bool insert_locked(const size_t& slot_index, const Key& key, const Payload& payload) {
+         auto& slot = this->slots[slot_index];
+
+         // Store directly in slot if possible
+         if (slot.key == Sentinel) {
+            slot.key = key;
+            slot.payload = payload;
+            return true;
+         }
+
+         // key already exists
+         if (slot.key == key)
+            return false;
+
+         // Initialize bucket chain if empty
+         std::uint32_t bucket_index = slot.buckets;
+         if (bucket_index == Base::NoBucket) {
+            const auto b = allocate_bucket();
+            this->arena[b].slots[0] = {.key = key, .payload = payload};
+            slot.buckets = b;
+            return true;
+         }
+
+         // Go through existing buckets and try to insert there if possible
+         for (;;) {
+            Bucket& bucket = this->arena[bucket_index];
+            for (size_t i = 0; i < BucketSize; i++) {
+               if (bucket.slots[i].key == Sentinel) {
+                  bucket.slots[i] = {.key = key, .payload = payload};
+                  return true;
+               } else if (bucket.slots[i].key == key) {
+                  // key already exists
+                  return false;
+               }
+            }
+
+            if (bucket.next == Base::NoBucket)
+               break;
+            bucket_index = bucket.next;
+         }
+
+         // Append a new bucket to the chain and add element there
+         const auto b = allocate_bucket();
+         this->arena[b].slots[0] = {.key = key, .payload = payload};
+         this->arena[bucket_index].next = b;
+         return true;
+      }
    };
 } // namespace hashtable
@@ -15,12 +15,49 @@
 #include <map>
 #include <optional>
 #include <random>
+#include <type_traits>
 #include <vector>
 #include <immintrin.h>
 
 #include "convenience/builtins.hpp"
+#include "directory.hpp"
+#include "reduction.hpp"
+#include "stats.hpp"
 
 namespace hashtable {
+   namespace cuckoo_internal {
+      /**
+       * Bucket layout agnostic slot accessors. Kicking strategies use these to
+       * work with both the generic array-of-slots Bucket and the SIMD
+       * specialization's struct-of-arrays Bucket.
+       */
+      template<class Bucket>
+      forceinline auto slot_key(const Bucket* b, const size_t i) {
+         if constexpr (requires { b->keys; })
+            return b->keys[i];
+         else
+            return b->slots[i].key;
+      }
+
+      template<class Bucket>
+      forceinline auto slot_payload(const Bucket* b, const size_t i) {
+         if constexpr (requires { b->payloads; })
+            return b->payloads[i];
+         else
+            return b->slots[i].payload;
+      }
+
+      template<class Bucket, class Key, class Payload>
+      forceinline void set_slot(Bucket* b, const size_t i, const Key& key, const Payload& payload) {
+         if constexpr (requires { b->keys; }) {
+            b->keys[i] = key;
+            b->payloads[i] = payload;
+         } else {
+            b->slots[i] = {.key = key, .payload = payload};
+         }
+      }
+   } // namespace cuckoo_internal
+
    /**
     * Place entry in bucket with more available space.
     * If both are full, kick from either bucket with 50% chance
@@ -39,26 +76,26 @@ namespace hashtable {
                                                                     const Payload& payload) {
          size_t c1 = 0, c2 = 0;
          for (size_t i = 0; i < BucketSize; i++) {
-            c1 += (b1->slots[i].key == Sentinel ? 0 : 1);
-            c2 += (b2->slots[i].key == Sentinel ? 0 : 1);
+            c1 += (cuckoo_internal::slot_key(b1, i) == Sentinel ? 0 : 1);
+            c2 += (cuckoo_internal::slot_key(b2, i) == Sentinel ? 0 : 1);
          }
 
          if (c1 <= c2 && c1 < BucketSize) {
-            b1->slots[c1] = {.key = key, .payload = payload};
+            cuckoo_internal::set_slot(b1, c1, key, payload);
             return std::nullopt;
          }
 
          if (c2 < BucketSize) {
-            b2->slots[c2] = {.key = key, .payload = payload};
+            cuckoo_internal::set_slot(b2, c2, key, payload);
             return std::nullopt;
          }
 
          const auto rng = rand_();
          const auto victim_bucket = rng & 0x1 ? b1 : b2;
          const size_t victim_index = rng % BucketSize;
-         Key victim_key = victim_bucket->slots[victim_index].key;
-         Payload victim_payload = victim_bucket->slots[victim_index].payload;
-         victim_bucket->slots[victim_index] = {.key = key, .payload = payload};
+         Key victim_key = cuckoo_internal::slot_key(victim_bucket, victim_index);
+         Payload victim_payload = cuckoo_internal::slot_payload(victim_bucket, victim_index);
+         cuckoo_internal::set_slot(victim_bucket, victim_index, key, payload);
          return std::make_optional(std::make_pair(victim_key, victim_payload));
       };
    };
@@ -87,26 +124,26 @@ namespace hashtable {
                                                                     const Payload& payload) {
          size_t c1 = 0, c2 = 0;
          for (size_t i = 0; i < BucketSize; i++) {
-            c1 += (b1->slots[i].key == Sentinel ? 0 : 1);
-            c2 += (b2->slots[i].key == Sentinel ? 0 : 1);
+            c1 += (cuckoo_internal::slot_key(b1, i) == Sentinel ? 0 : 1);
+            c2 += (cuckoo_internal::slot_key(b2, i) == Sentinel ? 0 : 1);
          }
 
          if (c1 < BucketSize) {
-            b1->slots[c1] = {.key = key, .payload = payload};
+            cuckoo_internal::set_slot(b1, c1, key, payload);
             return std::nullopt;
          }
 
          if (c2 < BucketSize) {
-            b2->slots[c2] = {.key = key, .payload = payload};
+            cuckoo_internal::set_slot(b2, c2, key, payload);
             return std::nullopt;
          }
 
          const auto rng = rand_();
          const auto victim_bucket = rng > threshold_ ? b1 : b2;
          const size_t victim_index = rng % BucketSize;
-         Key victim_key = victim_bucket->slots[victim_index].key;
-         Payload victim_payload = victim_bucket->slots[victim_index].payload;
-         victim_bucket->slots[victim_index] = {.key = key, .payload = payload};
+         Key victim_key = cuckoo_internal::slot_key(victim_bucket, victim_index);
+         Payload victim_payload = cuckoo_internal::slot_payload(victim_bucket, victim_index);
+         cuckoo_internal::set_slot(victim_bucket, victim_index, key, payload);
          return std::make_optional(std::make_pair(victim_key, victim_payload));
       };
    };
@@ -118,8 +155,32 @@ namespace hashtable {
     */
    using UnbiasedKicking = BiasedKicking<0>;
 
+   /**
+    * Breadth-first search kicking: instead of randomly walking the cuckoo
+    * graph one eviction at a time, insert searches for a shortest eviction
+    * path to a free slot before moving anything and then shifts entries
+    * along that path, moving each displaced entry exactly once. This keeps
+    * insert cost bounded and pushes achievable load factors higher than the
+    * random walk strategies.
+    *
+    * NOTE: unlike the other strategies this one must see the entire table
+    * rather than just two candidate buckets, i.e., it is implemented inside
+    * the insert loop (see Cuckoo::insert_bfs()) and this struct merely
+    * selects it.
+    */
+   struct BFSKicking {
+      /// upper bound on the amount of buckets a single insert may inspect
+      /// before giving up (bounds insert tail latency)
+      static constexpr size_t MaxScannedBuckets = 4096;
+
+      static std::string name() {
+         return "bfs_kicking";
+      }
+   };
+
    template<class Key, class Payload, size_t BucketSize, class HashFn1, class HashFn2, class ReductionFn1,
-            class ReductionFn2, class KickingFn, Key Sentinel = std::numeric_limits<Key>::max()>
+            class ReductionFn2, class KickingFn, class StatsMode = NoStats,
+            Key Sentinel = std::numeric_limits<Key>::max()>
    class Cuckoo {
      public:
       using KeyType = Key;
@@ -142,12 +203,33 @@ namespace hashtable {
          std::array<Slot, BucketSize> slots;
       } packed;
 
-      std::vector<Bucket> buckets;
+      Directory<Bucket> buckets;
+
+      /// amount of entries the overflow stash can absorb, see stash_insert()
+      static constexpr size_t StashSize = 32;
+
+      std::array<typename Bucket::Slot, StashSize> stash;
+      size_t stash_count = 0;
 
       std::mt19937 rand_; // RNG for moving items around
 
       size_t max_kick_cnt = 0, total_kick_cnt = 0;
 
+      /// snapshot restore path, see save()
+      Cuckoo(Directory<Bucket>&& directory, const HashFn1& hashfn1, const HashFn2& hashfn2)
+         : MaxKickCycleLength(50000), hashfn1(hashfn1), hashfn2(hashfn2),
+           reductionfn1(ReductionFn1(directory.size())), reductionfn2(ReductionFn2(directory.size())),
+           kickingfn(KickingFn()), buckets(std::move(directory)) {}
+
+      static SnapshotHeader snapshot_header() {
+         SnapshotHeader header;
+         header.key_bytes = sizeof(Key);
+         header.payload_bytes = sizeof(Payload);
+         header.slots_per_bucket = BucketSize;
+         std::strncpy(header.table_name, name().c_str(), SnapshotHeader::TableNameLength - 1);
+         return header;
+      }
+
      public:
       Cuckoo(const size_t& capacity, const HashFn1 hashfn1 = HashFn1(), const HashFn2 hashfn2 = HashFn2())
          : MaxKickCycleLength(50000), hashfn1(hashfn1), hashfn2(hashfn2),
@@ -155,6 +237,30 @@ namespace hashtable {
            reductionfn2(ReductionFn2(directory_address_count(capacity))), kickingfn(KickingFn()),
            buckets(directory_address_count(capacity)) {}
 
+      /**
+       * Restores a table from a snapshot file previously written by save().
+       * The directory is served directly off the mapped snapshot, i.e., a
+       * restarted process can answer lookups after a few page faults instead
+       * of a full rebuild. Hash function state is not serialized: the same
+       * hash functions the table was originally built with must be supplied.
+       */
+      explicit Cuckoo(const std::string& snapshot_filepath, const HashFn1 hashfn1 = HashFn1(),
+                      const HashFn2 hashfn2 = HashFn2())
+         : Cuckoo(Directory<Bucket>::from_snapshot(snapshot_filepath, snapshot_header()), hashfn1, hashfn2) {}
+
+      /**
+       * Serializes the table's directory to a snapshot file which can later
+       * be restored with the snapshot constructor.
+       *
+       * NOTE: the snapshot format has no stash section, i.e., tables that
+       * overflowed into the stash cannot be snapshotted.
+       */
+      void save(const std::string& snapshot_filepath) const {
+         if (unlikely(stash_count > 0))
+            throw std::runtime_error("cannot snapshot a table with stashed entries");
+         buckets.save(snapshot_filepath, snapshot_header());
+      }
+
       std::optional<Payload> lookup(const Key& key) const {
          const auto h1 = hashfn1(key);
          const auto i1 = reductionfn1(h1);
@@ -180,10 +286,162 @@ namespace hashtable {
             }
          }
 
-         return std::nullopt;
+         return lookup_stash(key);
+      }
+
+      /**
+       * Retrieves the payloads for a batch of keys at once, overlapping the
+       * directory cache misses of the individual lookups: both candidate
+       * buckets of every key in a group are prefetched before the first
+       * bucket is probed.
+       *
+       * Entries of out corresponding to keys that are not in the hashtable
+       * are left untouched.
+       *
+       * @param keys pointer to the first key of the batch
+       * @param n batch size
+       * @param out result array, n entries
+       * @return amount of keys that were found
+       */
+      size_t lookup_batch(const Key* keys, const size_t n, Payload* out) const {
+         constexpr size_t group_size = 16;
+         size_t i1s[group_size], i2s[group_size];
+         size_t found = 0;
+
+         for (size_t base = 0; base < n; base += group_size) {
+            const size_t group = std::min(group_size, n - base);
+
+            for (size_t j = 0; j < group; j++) {
+               const auto& key = keys[base + j];
+               const auto i1 = reductionfn1(hashfn1(key));
+               auto i2 = reductionfn2(hashfn2(key));
+               if (unlikely(i2 == i1)) {
+                  i2 = (i1 == buckets.size() - 1) ? 0 : i1 + 1;
+               }
+
+               i1s[j] = i1;
+               i2s[j] = i2;
+               prefetch(&buckets[i1], 0, 1);
+               prefetch(&buckets[i2], 0, 1);
+            }
+
+            for (size_t j = 0; j < group; j++) {
+               if (const auto payload = lookup_buckets(i1s[j], i2s[j], keys[base + j])) {
+                  out[base + j] = payload.value();
+                  found++;
+               }
+            }
+         }
+
+         return found;
+      }
+
+      /**
+       * Retrieves the payloads for a batch of keys with AMAC-style software
+       * pipelining (asynchronous memory access chaining): up to InFlight
+       * lookup state machines are live at any time, each suspending right
+       * after issuing the prefetch for its next candidate bucket (b1, then
+       * b2 only on a miss) while the others advance, i.e., the two dependent
+       * bucket loads are hidden behind independent work instead of stalling
+       * the core. Compared to lookup_batch this avoids prefetching b2 for
+       * keys already found in b1.
+       *
+       * Entries of out corresponding to keys that are not in the hashtable
+       * are left untouched.
+       *
+       * @param keys pointer to the first key of the batch
+       * @param n batch size
+       * @param out result array, n entries
+       * @return amount of keys that were found
+       */
+      template<size_t InFlight = 16>
+      size_t lookup_interleaved(const Key* keys, const size_t n, Payload* out) const {
+         struct Probe {
+            size_t key_index;
+            size_t bucket_index; // candidate bucket to inspect next
+            size_t alt_index; // second candidate, checked on a miss
+            bool last_candidate;
+         };
+
+         Probe probes[InFlight];
+         size_t active = 0; // probes[0..active) are in flight
+         size_t next_key = 0;
+         size_t found = 0;
+
+         const auto admit = [&](Probe& probe) {
+            const auto& key = keys[next_key];
+            const auto i1 = reductionfn1(hashfn1(key));
+            auto i2 = reductionfn2(hashfn2(key));
+            if (unlikely(i2 == i1)) {
+               i2 = (i1 == buckets.size() - 1) ? 0 : i1 + 1;
+            }
+
+            probe = {.key_index = next_key++, .bucket_index = i1, .alt_index = i2, .last_candidate = false};
+            prefetch(&buckets[i1], 0, 1);
+         };
+
+         while (active < InFlight && next_key < n)
+            admit(probes[active++]);
+
+         size_t cursor = 0;
+         while (active > 0) {
+            if (cursor >= active)
+               cursor = 0;
+            auto& probe = probes[cursor];
+
+            // inspect one (by now hopefully cache resident) candidate bucket
+            const Bucket& bucket = buckets[probe.bucket_index];
+            bool done = probe.last_candidate;
+            bool matched = false;
+            for (size_t i = 0; i < BucketSize; i++) {
+               if (bucket.slots[i].key == keys[probe.key_index]) {
+                  out[probe.key_index] = bucket.slots[i].payload;
+                  found++;
+                  done = true;
+                  matched = true;
+                  break;
+               }
+            }
+
+            // both candidate buckets missed -> last resort stash check
+            if (done && !matched) {
+               if (const auto payload = lookup_stash(keys[probe.key_index])) {
+                  out[probe.key_index] = payload.value();
+                  found++;
+               }
+            }
+
+            if (!done) {
+               // suspend: prefetch the second candidate, switch to another probe
+               probe.bucket_index = probe.alt_index;
+               probe.last_candidate = true;
+               prefetch(&buckets[probe.bucket_index], 0, 1);
+               cursor++;
+               continue;
+            }
+
+            // retire: hand this state machine the next key (if any)
+            if (next_key < n) {
+               admit(probe);
+               cursor++;
+            } else {
+               probe = probes[--active];
+            }
+         }
+
+         return found;
       }
 
       std::map<std::string, double> lookup_statistics(const std::vector<Key>& dataset) const {
+         // kick counters are only maintained (and reported) with FullStats,
+         // where this is an O(1) read without the dataset walk
+         if constexpr (StatsMode::enabled) {
+            UNUSED(dataset);
+            return {{"total_kick_count", total_kick_cnt},
+                    {"max_kick_count", max_kick_cnt},
+                    {"stash_size", stash_count}};
+         }
+
          size_t primary_key_cnt = 0;
 
          for (const auto& key : dataset) {
@@ -198,16 +456,38 @@ namespace hashtable {
 
          return {{"primary_key_ratio",
                   static_cast<long double>(primary_key_cnt) / static_cast<long double>(dataset.size())},
-                 {"total_kick_count", total_kick_cnt},
-                 {"max_kick_count", max_kick_cnt}};
+                 {"stash_size", stash_count}};
       }
 
       void insert(const Key& key, const Payload& value) {
-         insert(key, value, 0);
+         if constexpr (std::is_same<KickingFn, BFSKicking>::value)
+            insert_bfs(key, value);
+         else
+            insert(key, value, 0);
+      }
+
+      /**
+       * Invokes f(key, payload) for every entry physically stored in the
+       * directory bucket range [from, from + n), e.g., to migrate entries
+       * during an incremental resize (see Growing). Stash entries are
+       * reported alongside the final directory bucket.
+       */
+      template<class F>
+      void for_each_in_buckets(const size_t& from, const size_t& n, F f) const {
+         for (size_t b = from; b < from + n; b++) {
+            const auto& bucket = buckets[b];
+            for (size_t i = 0; i < BucketSize; i++)
+               if (bucket.slots[i].key != Sentinel)
+                  f(bucket.slots[i].key, bucket.slots[i].payload);
+         }
+
+         if (from + n >= buckets.size())
+            for (size_t i = 0; i < stash_count; i++)
+               f(stash[i].key, stash[i].payload);
       }
 
       size_t byte_size() const {
-         return sizeof(decltype(*this)) + buckets.size() * bucket_byte_size();
+         return sizeof(decltype(*this)) + buckets.byte_size();
       }
 
       static constexpr forceinline size_t bucket_byte_size() {
@@ -215,7 +495,8 @@ namespace hashtable {
       }
 
       static forceinline std::string name() {
-         return "cuckoo_" + std::to_string(BucketSize) + "_" + KickingFn::name();
+         return "cuckoo_" + std::to_string(BucketSize) + "_" + KickingFn::name() +
+            (StatsMode::enabled ? "_" + StatsMode::name() : "");
       }
 
       static forceinline std::string hash_name() {
@@ -231,6 +512,9 @@ namespace hashtable {
       }
 
       static constexpr forceinline size_t directory_address_count(const size_t& capacity) {
+         // power of two directory mode, see requires_pow2_directory
+         if constexpr (requires_pow2_directory<ReductionFn1>::value || requires_pow2_directory<ReductionFn2>::value)
+            return next_pow2((capacity + BucketSize - 1) / BucketSize);
          return (capacity + BucketSize - 1) / BucketSize;
       }
 
@@ -238,16 +522,70 @@ namespace hashtable {
          for (auto& bucket : buckets)
             for (auto& slot : bucket.slots)
                slot.key = Sentinel;
+
+         for (auto& slot : stash)
+            slot.key = Sentinel;
+         stash_count = 0;
+
+         if constexpr (StatsMode::enabled) {
+            max_kick_cnt = 0;
+            total_kick_cnt = 0;
+         }
       }
 
      private:
+      /**
+       * Resolves a lookup against both (already computed) candidate buckets.
+       */
+      forceinline std::optional<Payload> lookup_buckets(const size_t& i1, const size_t& i2, const Key& key) const {
+         const Bucket* b1 = &buckets[i1];
+         for (size_t i = 0; i < BucketSize; i++) {
+            if (b1->slots[i].key == key)
+               return std::make_optional(b1->slots[i].payload);
+         }
+
+         const Bucket* b2 = &buckets[i2];
+         for (size_t i = 0; i < BucketSize; i++) {
+            if (b2->slots[i].key == key)
+               return std::make_optional(b2->slots[i].payload);
+         }
+
+         return lookup_stash(key);
+      }
+
+      /// last resort lookup against the overflow stash. Usually empty, i.e.,
+      /// resolved with a single compare against stash_count
+      forceinline std::optional<Payload> lookup_stash(const Key& key) const {
+         for (size_t i = 0; i < stash_count; i++)
+            if (stash[i].key == key)
+               return std::make_optional(stash[i].payload);
+         return std::nullopt;
+      }
+
+      /**
+       * Absorbs an entry the kicking strategy failed to place. Even a tiny
+       * stash drives the insert failure probability to effectively zero,
+       * i.e., tables can be loaded beyond the kicking strategy's achievable
+       * load factor without rebuild-and-retry logic in the loader.
+       */
+      void stash_insert(const Key& key, const Payload& payload) {
+         if (unlikely(stash_count == StashSize))
+            throw std::runtime_error("insert failed, overflow stash (" + std::to_string(StashSize) +
+                                     " entries) is full, table is too full");
+         stash[stash_count] = {.key = key, .payload = payload};
+         stash_count++;
+      }
+
       void insert(Key key, Payload payload, size_t kick_count) {
       start:
          if (kick_count > MaxKickCycleLength) {
-            throw std::runtime_error("maximum kick cycle length (" + std::to_string(MaxKickCycleLength) + ") reached");
+            stash_insert(key, payload);
+            return;
+         }
+         if constexpr (StatsMode::enabled) {
+            max_kick_cnt = std::max(max_kick_cnt, kick_count);
+            total_kick_cnt += kick_count > 0;
          }
-         max_kick_cnt = std::max(max_kick_cnt, kick_count);
-         total_kick_cnt += kick_count > 0;
 
          const auto h1 = hashfn1(key);
          const auto i1 = reductionfn1(h1);
@@ -271,6 +609,12 @@ namespace hashtable {
                return;
             }
          }
+         for (size_t i = 0; i < stash_count; i++) {
+            if (stash[i].key == key) {
+               stash[i].payload = payload;
+               return;
+            }
+         }
 
          // Way to go Mr. Stroustrup
          if (const auto kicked =
@@ -281,188 +625,625 @@ namespace hashtable {
             goto start;
          }
       }
+
+      /// index of the first empty slot in bucket, or BucketSize if it is full
+      forceinline size_t free_slot(const Bucket& bucket) const {
+         for (size_t i = 0; i < BucketSize; i++)
+            if (bucket.slots[i].key == Sentinel)
+               return i;
+         return BucketSize;
+      }
+
+      /// the other candidate bucket of the key currently stored in bucket current
+      forceinline size_t alternate_bucket(const Key& key, const size_t& current) const {
+         const auto j1 = reductionfn1(hashfn1(key));
+         auto j2 = reductionfn2(hashfn2(key));
+         if (unlikely(j2 == j1)) {
+            j2 = (j1 == buckets.size() - 1) ? 0 : j1 + 1;
+         }
+         return current == j1 ? j2 : j1;
+      }
+
+      /**
+       * Insert path for BFSKicking: breadth-first search from both candidate
+       * buckets for the nearest bucket with a free slot, then shift entries
+       * backwards along the discovered eviction path. Each displaced entry
+       * moves exactly once, i.e., insert cost is bounded by the BFS scan
+       * limit instead of a potentially unbounded random walk.
+       */
+      void insert_bfs(const Key& key, const Payload& payload) {
+         constexpr size_t None = std::numeric_limits<size_t>::max();
+
+         const auto i1 = reductionfn1(hashfn1(key));
+         auto i2 = reductionfn2(hashfn2(key));
+         if (unlikely(i2 == i1)) {
+            i2 = (i1 == buckets.size() - 1) ? 0 : i1 + 1;
+         }
+
+         // Update old value if the key is already in the table
+         Bucket* b1 = &buckets[i1];
+         Bucket* b2 = &buckets[i2];
+         for (size_t i = 0; i < BucketSize; i++) {
+            if (b1->slots[i].key == key) {
+               b1->slots[i].payload = payload;
+               return;
+            }
+            if (b2->slots[i].key == key) {
+               b2->slots[i].payload = payload;
+               return;
+            }
+         }
+         for (size_t i = 0; i < stash_count; i++) {
+            if (stash[i].key == key) {
+               stash[i].payload = payload;
+               return;
+            }
+         }
+
+         struct Node {
+            size_t bucket_index;
+            size_t parent; // index into visited, None for the two roots
+            size_t parent_slot; // slot of the parent's bucket that was followed
+         };
+         std::vector<Node> visited;
+         visited.reserve(KickingFn::MaxScannedBuckets);
+         visited.push_back({i1, None, None});
+         visited.push_back({i2, None, None});
+
+         size_t found = None;
+         for (size_t head = 0; head < visited.size(); head++) {
+            if (free_slot(buckets[visited[head].bucket_index]) < BucketSize) {
+               found = head;
+               break;
+            }
+
+            if (visited.size() + BucketSize > KickingFn::MaxScannedBuckets)
+               continue; // scan limit reached, drain the remaining queue
+            for (size_t i = 0; i < BucketSize; i++) {
+               const auto& slot = buckets[visited[head].bucket_index].slots[i];
+               visited.push_back({alternate_bucket(slot.key, visited[head].bucket_index), head, i});
+            }
+         }
+
+         if (unlikely(found == None)) {
+            stash_insert(key, payload);
+            return;
+         }
+
+         // shift entries backwards along the path, then place the new key in
+         // the freed slot of its candidate bucket
+         size_t hole = free_slot(buckets[visited[found].bucket_index]);
+         size_t kicks = 0;
+         while (visited[found].parent != None) {
+            const auto& parent = visited[visited[found].parent];
+            buckets[visited[found].bucket_index].slots[hole] = buckets[parent.bucket_index].slots[visited[found].parent_slot];
+            hole = visited[found].parent_slot;
+            found = visited[found].parent;
+            kicks++;
+         }
+         buckets[visited[found].bucket_index].slots[hole] = {.key = key, .payload = payload};
+
+         if constexpr (StatsMode::enabled) {
+            max_kick_cnt = std::max(max_kick_cnt, kicks);
+            total_kick_cnt += kicks > 0;
+         }
+      }
    };
 
-   //   template<class Payload, class HashFn1, class HashFn2, class ReductionFn1, class ReductionFn2, class KickingFn,
-   //            uint32_t Sentinel>
-   //   class Cuckoo<uint32_t, Payload, 8, HashFn1, HashFn2, ReductionFn1, ReductionFn2, KickingFn, Sentinel> {
-   //     public:
-   //      typedef uint32_t KeyType;
-   //      typedef Payload PayloadType;
-   //
-   //     private:
-   //      static constexpr uint32_t BucketSize = 8;
-   //      const size_t MaxKickCycleLength;
-   //
-   //      const HashFn1 hashfn1;
-   //      const HashFn2 hashfn2;
-   //      const ReductionFn1 reductionfn1;
-   //      const ReductionFn2 reductionfn2;
-   //      KickingFn kickingfn;
-   //
-   //      struct Bucket {
-   //         uint32_t keys[BucketSize] __attribute((aligned(32)));
-   //         Payload values[BucketSize];
-   //      } packed;
-   //
-   //      Bucket* buckets_;
-   //      size_t num_buckets_; // Total number of buckets
-   //
-   //      std::mt19937 rand_; // RNG for moving items around
-   //
-   //     public:
-   //   Cuckoo(const size_t& capacity)
-   //      : MaxKickCycleLength(4096), hashfn1(HashFn1()), hashfn2(HashFn2()),
-   //        reductionfn1(ReductionFn1(directory_address_count(capacity))),
-   //        reductionfn2(ReductionFn2(directory_address_count(capacity))), kickingfn(KickingFn()),
-   //        num_buckets_(directory_address_count(capacity)) {
-   //      // Allocate memory
-   //      int r = posix_memalign(reinterpret_cast<void**>(&buckets_), 32, num_buckets_ * sizeof(Bucket));
-   //      if (r != 0)
-   //         throw std::runtime_error("Could not memalign allocate for cuckoo hash map");
-   //
-   //      // Ensure all slots are in cleared state
-   //      clear();
-   //   }
-   //
-   //      ~Cuckoo() {
-   //         free(buckets_);
-   //      }
-   //
-   //      std::optional<Payload> lookup(const uint32_t& key) const {
-   //         const auto h1 = hashfn1(key);
-   //         const auto i1 = reductionfn1(h1);
-   //
-   //         Bucket* b1 = &buckets_[i1];
-   //         __m256i vkey = _mm256_set1_epi32(key);
-   //         __m256i vbucket = _mm256_load_si256(reinterpret_cast<const __m256i*>(&b1->keys));
-   //         __m256i cmp = _mm256_cmpeq_epi32(vkey, vbucket);
-   //         int mask = _mm256_movemask_epi8(cmp);
-   //         if (mask != 0) {
-   //            int index = __builtin_ctz(mask) / 4;
-   //            auto val = b1->values[index];
-   //            return std::make_optional(val);
-   //         }
-   //
-   //         auto i2 = reductionfn2(hashfn2(key, h1));
-   //         if (i2 == i1) {
-   //            i2 = (i1 == num_buckets_ - 1) ? 0 : i1 + 1;
-   //         }
-   //         Bucket* b2 = &buckets_[i2];
-   //         vbucket = _mm256_load_si256(reinterpret_cast<const __m256i*>(&b2->keys));
-   //         cmp = _mm256_cmpeq_epi32(vkey, vbucket);
-   //         mask = _mm256_movemask_epi8(cmp);
-   //         if (mask != 0) {
-   //            int index = __builtin_ctz(mask) / 4;
-   //            auto val = b2->values[index];
-   //            return std::make_optional(val);
-   //         }
-   //
-   //         return std::nullopt;
-   //      }
-   //
-   //      std::map<std::string, std::string> lookup_statistics(const std::vector<KeyType>& dataset) {
-   //         size_t primary_key_cnt;
-   //
-   //         for (const auto& key : dataset) {
-   //            const auto h1 = hashfn1(key);
-   //            const auto i1 = reductionfn1(h1);
-   //
-   //            Bucket* b1 = &buckets_[i1];
-   //            __m256i vkey = _mm256_set1_epi32(key);
-   //            __m256i vbucket = _mm256_load_si256(reinterpret_cast<const __m256i*>(&b1->keys));
-   //            __m256i cmp = _mm256_cmpeq_epi32(vkey, vbucket);
-   //            int mask = _mm256_movemask_epi8(cmp);
-   //            if (mask != 0) {
-   //               primary_key_cnt++;
-   //            }
-   //         }
-   //
-   //         return {
-   //            {"primary_key_ratio",
-   //             std::to_string(static_cast<long double>(primary_key_cnt) / static_cast<long double>(dataset.size()))},
-   //         };
-   //      }
-   //
-   //      void insert(const uint32_t& key, const Payload& value) {
-   //         insert(key, value, 0);
-   //      }
-   //
-   //      static constexpr forceinline size_t bucket_byte_size() {
-   //         return sizeof(Bucket);
-   //      }
-   //
-   //      static forceinline std::string name() {
-   //         return "simd_cuckoo_" + KickingFn::name();
-   //      }
-   //
-   //      static forceinline std::string hash_name() {
-   //         return HashFn1::name() + "-" + HashFn2::name();
-   //      }
-   //
-   //      static forceinline std::string reducer_name() {
-   //         return ReductionFn1::name() + "-" + ReductionFn2::name();
-   //      }
-   //
-   //      static constexpr forceinline size_t bucket_size() {
-   //         return BucketSize;
-   //      }
-   //
-   //      static constexpr forceinline size_t directory_address_count(const size_t& capacity) {
-   //         return (capacity + BucketSize - 1) / BucketSize;
-   //      }
-   //
-   //      void clear() {
-   //         for (size_t i = 0; i < num_buckets_; i++) {
-   //            for (size_t j = 0; j < BucketSize; j++) {
-   //               buckets_[i].keys[j] = Sentinel;
-   //            }
-   //         }
-   //      }
-   //
-   //     private:
-   //      void insert(const uint32_t& key, const Payload& value, size_t kick_count) {
-   //         // TODO: track max kick_count for result graphs
-   //         if (kick_count > MaxKickCycleLength) {
-   //            throw std::runtime_error("maximum kick cycle length (" + std::to_string(MaxKickCycleLength) + ") reached");
-   //         }
-   //
-   //         const auto h1 = hashfn1(key);
-   //         const auto i1 = reductionfn1(h1);
-   //         auto i2 = reductionfn2(hashfn2(key, h1));
-   //
-   //         if (unlikely(i2 == i1)) {
-   //            i2 = (i1 == num_buckets_ - 1) ? 0 : i1 + 1;
-   //         }
-   //
-   //         Bucket* b1 = &buckets_[i1];
-   //         Bucket* b2 = &buckets_[i2];
-   //
-   //         // Update old value if the key is already in the table
-   //         __m256i vkey = _mm256_set1_epi32(key);
-   //         __m256i vbucket = _mm256_load_si256(reinterpret_cast<const __m256i*>(&b1->keys));
-   //         __m256i cmp = _mm256_cmpeq_epi32(vkey, vbucket);
-   //         int mask = _mm256_movemask_epi8(cmp);
-   //         if (mask != 0) {
-   //            int index = __builtin_ctz(mask) / 4;
-   //            b1->values[index] = value;
-   //            return;
-   //         }
-   //
-   //         vbucket = _mm256_load_si256(reinterpret_cast<const __m256i*>(&b2->keys));
-   //         cmp = _mm256_cmpeq_epi32(vkey, vbucket);
-   //         mask = _mm256_movemask_epi8(cmp);
-   //         if (mask != 0) {
-   //            int index = __builtin_ctz(mask) / 4;
-   //            b2->values[index] = value;
-   //            return;
-   //         }
-   //
-   //         // Way to go Mr. Stroustrup
-   //         if (const auto kicked =
-   //                kickingfn.template operator()<Bucket, uint32_t, Payload, BucketSize, Sentinel>(b1, b2, key, value)) {
-   //            insert(kicked.value().first, kicked.value().second, kick_count + 1);
-   //         }
-   //      }
-   //   };
+   /**
+    * Cuckoo variant probing entire buckets with SIMD compares. Keys and
+    * payloads are kept in struct-of-arrays layout per bucket so that all keys
+    * of a bucket can be matched with a single aligned vector load.
+    *
+    * Vectorized configurations (selected automatically at compile time):
+    *   - 4 byte keys, BucketSize 8: AVX2 (_mm256_cmpeq_epi32)
+    *   - 8 byte keys, BucketSize 4: AVX2 (_mm256_cmpeq_epi64)
+    *   - 8 byte keys, BucketSize 8: AVX-512 (_mm512_cmpeq_epi64_mask)
+    * Other configurations fall back to a scalar probe loop.
+    */
+   template<class Key, class Payload, size_t BucketSize, class HashFn1, class HashFn2, class ReductionFn1,
+            class ReductionFn2, class KickingFn, class StatsMode = NoStats,
+            Key Sentinel = std::numeric_limits<Key>::max()>
+   class SIMDCuckoo {
+     public:
+      using KeyType = Key;
+      using PayloadType = Payload;
+
+     private:
+      static_assert(std::is_trivially_copyable<Key>::value && std::is_trivially_copyable<Payload>::value,
+                    "SIMDCuckoo requires trivially copyable keys and payloads");
+
+      const size_t MaxKickCycleLength;
+      const HashFn1 hashfn1;
+      const HashFn2 hashfn2;
+      const ReductionFn1 reductionfn1;
+      const ReductionFn2 reductionfn2;
+      KickingFn kickingfn;
+
+      struct Bucket {
+         Key keys[BucketSize] alignit(sizeof(Key) * BucketSize >= 64 ? 64 : 32);
+         Payload payloads[BucketSize];
+      };
+
+      Directory<Bucket> buckets_;
+
+      /// amount of entries the overflow stash can absorb, see stash_insert().
+      /// Laid out as full buckets so the stash is scanned with the same SIMD
+      /// bucket match as the directory
+      static constexpr size_t StashSize = 32;
+      static constexpr size_t StashBuckets = (StashSize + BucketSize - 1) / BucketSize;
+
+      std::array<Bucket, StashBuckets> stash;
+      size_t stash_count = 0;
+
+      size_t max_kick_cnt = 0, total_kick_cnt = 0;
+
+      /// snapshot restore path, see save()
+      SIMDCuckoo(Directory<Bucket>&& directory, const HashFn1& hashfn1, const HashFn2& hashfn2)
+         : MaxKickCycleLength(50000), hashfn1(hashfn1), hashfn2(hashfn2),
+           reductionfn1(ReductionFn1(directory.size())), reductionfn2(ReductionFn2(directory.size())),
+           kickingfn(KickingFn()), buckets_(std::move(directory)) {
+         clear_stash();
+      }
+
+      static SnapshotHeader snapshot_header() {
+         SnapshotHeader header;
+         header.key_bytes = sizeof(Key);
+         header.payload_bytes = sizeof(Payload);
+         header.slots_per_bucket = BucketSize;
+         std::strncpy(header.table_name, name().c_str(), SnapshotHeader::TableNameLength - 1);
+         return header;
+      }
+
+     public:
+      explicit SIMDCuckoo(const size_t& capacity, const HashFn1 hashfn1 = HashFn1(),
+                          const HashFn2 hashfn2 = HashFn2())
+         : MaxKickCycleLength(50000), hashfn1(hashfn1), hashfn2(hashfn2),
+           reductionfn1(ReductionFn1(directory_address_count(capacity))),
+           reductionfn2(ReductionFn2(directory_address_count(capacity))), kickingfn(KickingFn()),
+           buckets_(directory_address_count(capacity)) {
+         // Bucket's alignment specification guarantees that vector loads on
+         // keys never split, Directory's allocation honors it
+
+         // Ensure all slots are in cleared state
+         clear();
+      }
+
+      /**
+       * Restores a table from a snapshot file previously written by save().
+       * The directory is served directly off the mapped snapshot, i.e., a
+       * restarted process can answer lookups after a few page faults instead
+       * of a full rebuild. Hash function state is not serialized: the same
+       * hash functions the table was originally built with must be supplied.
+       */
+      explicit SIMDCuckoo(const std::string& snapshot_filepath, const HashFn1 hashfn1 = HashFn1(),
+                          const HashFn2 hashfn2 = HashFn2())
+         : SIMDCuckoo(Directory<Bucket>::from_snapshot(snapshot_filepath, snapshot_header()), hashfn1, hashfn2) {}
+
+      SIMDCuckoo(SIMDCuckoo&&) noexcept = default;
+
+      SIMDCuckoo(const SIMDCuckoo&) = delete;
+      SIMDCuckoo& operator=(const SIMDCuckoo&) = delete;
+      SIMDCuckoo& operator=(SIMDCuckoo&&) = delete;
+
+      /**
+       * Serializes the table's directory to a snapshot file which can later
+       * be restored with the snapshot constructor.
+       *
+       * NOTE: the snapshot format has no stash section, i.e., tables that
+       * overflowed into the stash cannot be snapshotted.
+       */
+      void save(const std::string& snapshot_filepath) const {
+         if (unlikely(stash_count > 0))
+            throw std::runtime_error("cannot snapshot a table with stashed entries");
+         buckets_.save(snapshot_filepath, snapshot_header());
+      }
+
+      std::optional<Payload> lookup(const Key& key) const {
+         const auto h1 = hashfn1(key);
+         const auto i1 = reductionfn1(h1);
+
+         const Bucket* b1 = &buckets_[i1];
+         if (const auto index = match_bucket(b1, key))
+            return std::make_optional(b1->payloads[index.value()]);
+
+         auto i2 = reductionfn2(hashfn2(key));
+         if (i2 == i1) {
+            i2 = (i1 == buckets_.size() - 1) ? 0 : i1 + 1;
+         }
+
+         const Bucket* b2 = &buckets_[i2];
+         if (const auto index = match_bucket(b2, key))
+            return std::make_optional(b2->payloads[index.value()]);
+
+         return lookup_stash(key);
+      }
+
+      /**
+       * Retrieves the payloads for a batch of keys at once, overlapping the
+       * directory cache misses of the individual lookups: both candidate
+       * buckets of every key in a group are prefetched before the first
+       * bucket is probed.
+       *
+       * Entries of out corresponding to keys that are not in the hashtable
+       * are left untouched.
+       *
+       * @param keys pointer to the first key of the batch
+       * @param n batch size
+       * @param out result array, n entries
+       * @return amount of keys that were found
+       */
+      size_t lookup_batch(const Key* keys, const size_t n, Payload* out) const {
+         constexpr size_t group_size = 16;
+         size_t i1s[group_size], i2s[group_size];
+         size_t found = 0;
+
+         for (size_t base = 0; base < n; base += group_size) {
+            const size_t group = std::min(group_size, n - base);
+
+            for (size_t j = 0; j < group; j++) {
+               const auto& key = keys[base + j];
+               const auto i1 = reductionfn1(hashfn1(key));
+               auto i2 = reductionfn2(hashfn2(key));
+               if (unlikely(i2 == i1)) {
+                  i2 = (i1 == buckets_.size() - 1) ? 0 : i1 + 1;
+               }
+
+               i1s[j] = i1;
+               i2s[j] = i2;
+               prefetch(&buckets_[i1], 0, 1);
+               prefetch(&buckets_[i2], 0, 1);
+            }
+
+            for (size_t j = 0; j < group; j++) {
+               const auto& key = keys[base + j];
+               const Bucket* b1 = &buckets_[i1s[j]];
+               if (const auto index = match_bucket(b1, key)) {
+                  out[base + j] = b1->payloads[index.value()];
+                  found++;
+                  continue;
+               }
+
+               const Bucket* b2 = &buckets_[i2s[j]];
+               if (const auto index = match_bucket(b2, key)) {
+                  out[base + j] = b2->payloads[index.value()];
+                  found++;
+                  continue;
+               }
+
+               if (const auto payload = lookup_stash(key)) {
+                  out[base + j] = payload.value();
+                  found++;
+               }
+            }
+         }
+
+         return found;
+      }
+
+      std::map<std::string, double> lookup_statistics(const std::vector<Key>& dataset) const {
+         // kick counters are only maintained (and reported) with FullStats,
+         // where this is an O(1) read without the dataset walk
+         if constexpr (StatsMode::enabled) {
+            UNUSED(dataset);
+            return {{"total_kick_count", total_kick_cnt},
+                    {"max_kick_count", max_kick_cnt},
+                    {"stash_size", stash_count}};
+         }
+
+         size_t primary_key_cnt = 0;
+
+         for (const auto& key : dataset) {
+            const auto h1 = hashfn1(key);
+            const auto i1 = reductionfn1(h1);
+
+            if (match_bucket(&buckets_[i1], key))
+               primary_key_cnt++;
+         }
+
+         return {{"primary_key_ratio",
+                  static_cast<long double>(primary_key_cnt) / static_cast<long double>(dataset.size())},
+                 {"stash_size", stash_count}};
+      }
+
+      void insert(const Key& key, const Payload& value) {
+         if constexpr (std::is_same<KickingFn, BFSKicking>::value)
+            insert_bfs(key, value);
+         else
+            insert(key, value, 0);
+      }
+
+      /**
+       * Invokes f(key, payload) for every entry physically stored in the
+       * directory bucket range [from, from + n), e.g., to migrate entries
+       * during an incremental resize (see Growing). Stash entries are
+       * reported alongside the final directory bucket.
+       */
+      template<class F>
+      void for_each_in_buckets(const size_t& from, const size_t& n, F f) const {
+         for (size_t b = from; b < from + n; b++) {
+            const auto& bucket = buckets_[b];
+            for (size_t i = 0; i < BucketSize; i++)
+               if (bucket.keys[i] != Sentinel)
+                  f(bucket.keys[i], bucket.payloads[i]);
+         }
+
+         if (from + n >= buckets_.size())
+            for (size_t i = 0; i < stash_count; i++)
+               f(stash[i / BucketSize].keys[i % BucketSize], stash[i / BucketSize].payloads[i % BucketSize]);
+      }
+
+      size_t byte_size() const {
+         return sizeof(decltype(*this)) + buckets_.byte_size();
+      }
+
+      static constexpr forceinline size_t bucket_byte_size() {
+         return sizeof(Bucket);
+      }
+
+      static forceinline std::string name() {
+         return "simd_cuckoo_" + std::to_string(BucketSize) + "_" + KickingFn::name() +
+            (StatsMode::enabled ? "_" + StatsMode::name() : "");
+      }
+
+      static forceinline std::string hash_name() {
+         return HashFn1::name() + "-" + HashFn2::name();
+      }
+
+      static forceinline std::string reducer_name() {
+         return ReductionFn1::name() + "-" + ReductionFn2::name();
+      }
+
+      static constexpr forceinline size_t bucket_size() {
+         return BucketSize;
+      }
+
+      static constexpr forceinline size_t directory_address_count(const size_t& capacity) {
+         // power of two directory mode, see requires_pow2_directory
+         if constexpr (requires_pow2_directory<ReductionFn1>::value || requires_pow2_directory<ReductionFn2>::value)
+            return next_pow2((capacity + BucketSize - 1) / BucketSize);
+         return (capacity + BucketSize - 1) / BucketSize;
+      }
+
+      void clear() {
+         for (size_t i = 0; i < buckets_.size(); i++)
+            for (size_t j = 0; j < BucketSize; j++)
+               buckets_[i].keys[j] = Sentinel;
+
+         clear_stash();
+
+         if constexpr (StatsMode::enabled) {
+            max_kick_cnt = 0;
+            total_kick_cnt = 0;
+         }
+      }
+
+     private:
+      void clear_stash() {
+         for (auto& bucket : stash)
+            for (size_t i = 0; i < BucketSize; i++)
+               bucket.keys[i] = Sentinel;
+         stash_count = 0;
+      }
+
+      /// last resort lookup against the overflow stash. Usually empty, i.e.,
+      /// resolved with a single compare against stash_count
+      forceinline std::optional<Payload> lookup_stash(const Key& key) const {
+         if (likely(stash_count == 0))
+            return std::nullopt;
+
+         for (size_t b = 0; b < StashBuckets; b++)
+            if (const auto index = match_bucket(&stash[b], key))
+               return std::make_optional(stash[b].payloads[index.value()]);
+         return std::nullopt;
+      }
+
+      /**
+       * Absorbs an entry the kicking strategy failed to place. Even a tiny
+       * stash drives the insert failure probability to effectively zero,
+       * i.e., tables can be loaded beyond the kicking strategy's achievable
+       * load factor without rebuild-and-retry logic in the loader.
+       */
+      void stash_insert(const Key& key, const Payload& payload) {
+         if (unlikely(stash_count == StashSize))
+            throw std::runtime_error("insert failed, overflow stash (" + std::to_string(StashSize) +
+                                     " entries) is full, table is too full");
+         stash[stash_count / BucketSize].keys[stash_count % BucketSize] = key;
+         stash[stash_count / BucketSize].payloads[stash_count % BucketSize] = payload;
+         stash_count++;
+      }
+      /**
+       * Matches key against all keys of bucket b at once, if a SIMD code path
+       * exists for this Key/BucketSize configuration.
+       *
+       * @return index of the matching slot, or std::nullopt if the key is not in b
+       */
+      forceinline std::optional<size_t> match_bucket(const Bucket* b, const Key& key) const {
+#ifdef __AVX512F__
+         if constexpr (sizeof(Key) == 8 && BucketSize == 8) {
+            const __m512i vkey = _mm512_set1_epi64(static_cast<long long>(key));
+            const __m512i vbucket = _mm512_load_si512(reinterpret_cast<const void*>(&b->keys));
+            const auto mask = static_cast<unsigned>(_mm512_cmpeq_epi64_mask(vkey, vbucket));
+            if (mask != 0)
+               return std::make_optional(static_cast<size_t>(__builtin_ctz(mask)));
+            return std::nullopt;
+         }
+#endif
+#ifdef __AVX2__
+         if constexpr (sizeof(Key) == 8 && BucketSize == 4) {
+            const __m256i vkey = _mm256_set1_epi64x(static_cast<long long>(key));
+            const __m256i vbucket = _mm256_load_si256(reinterpret_cast<const __m256i*>(&b->keys));
+            const auto mask =
+               static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi64(vkey, vbucket)));
+            if (mask != 0)
+               return std::make_optional(static_cast<size_t>(__builtin_ctz(mask)) / 8);
+            return std::nullopt;
+         }
+
+         if constexpr (sizeof(Key) == 4 && BucketSize == 8) {
+            const __m256i vkey = _mm256_set1_epi32(static_cast<int>(key));
+            const __m256i vbucket = _mm256_load_si256(reinterpret_cast<const __m256i*>(&b->keys));
+            const auto mask =
+               static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi32(vkey, vbucket)));
+            if (mask != 0)
+               return std::make_optional(static_cast<size_t>(__builtin_ctz(mask)) / 4);
+            return std::nullopt;
+         }
+#endif
+
+         // Scalar fallback for configurations without a SIMD code path
+         for (size_t i = 0; i < BucketSize; i++)
+            if (b->keys[i] == key)
+               return std::make_optional(i);
+         return std::nullopt;
+      }
+
+      void insert(Key key, Payload payload, size_t kick_count) {
+      start:
+         if (kick_count > MaxKickCycleLength) {
+            stash_insert(key, payload);
+            return;
+         }
+         if constexpr (StatsMode::enabled) {
+            max_kick_cnt = std::max(max_kick_cnt, kick_count);
+            total_kick_cnt += kick_count > 0;
+         }
+
+         const auto h1 = hashfn1(key);
+         const auto i1 = reductionfn1(h1);
+         auto i2 = reductionfn2(hashfn2(key));
+
+         if (unlikely(i2 == i1)) {
+            i2 = (i1 == buckets_.size() - 1) ? 0 : i1 + 1;
+         }
+
+         Bucket* b1 = &buckets_[i1];
+         Bucket* b2 = &buckets_[i2];
+
+         // Update old value if the key is already in the table
+         if (const auto index = match_bucket(b1, key)) {
+            b1->payloads[index.value()] = payload;
+            return;
+         }
+         if (const auto index = match_bucket(b2, key)) {
+            b2->payloads[index.value()] = payload;
+            return;
+         }
+         if (unlikely(stash_count > 0)) {
+            for (size_t b = 0; b < StashBuckets; b++) {
+               if (const auto index = match_bucket(&stash[b], key)) {
+                  stash[b].payloads[index.value()] = payload;
+                  return;
+               }
+            }
+         }
+
+         // Way to go Mr. Stroustrup
+         if (const auto kicked =
+                kickingfn.template operator()<Bucket, Key, Payload, BucketSize, Sentinel>(b1, b2, key, payload)) {
+            key = kicked.value().first;
+            payload = kicked.value().second;
+            kick_count++;
+            goto start;
+         }
+      }
+
+      /// the other candidate bucket of the key currently stored in bucket current
+      forceinline size_t alternate_bucket(const Key& key, const size_t& current) const {
+         const auto j1 = reductionfn1(hashfn1(key));
+         auto j2 = reductionfn2(hashfn2(key));
+         if (unlikely(j2 == j1)) {
+            j2 = (j1 == buckets_.size() - 1) ? 0 : j1 + 1;
+         }
+         return current == j1 ? j2 : j1;
+      }
+
+      /**
+       * Insert path for BFSKicking, see Cuckoo::insert_bfs(). Free slots are
+       * located with the same SIMD bucket match as lookups (a free slot is
+       * simply a slot holding the Sentinel).
+       */
+      void insert_bfs(const Key& key, const Payload& payload) {
+         constexpr size_t None = std::numeric_limits<size_t>::max();
+
+         const auto i1 = reductionfn1(hashfn1(key));
+         auto i2 = reductionfn2(hashfn2(key));
+         if (unlikely(i2 == i1)) {
+            i2 = (i1 == buckets_.size() - 1) ? 0 : i1 + 1;
+         }
+
+         // Update old value if the key is already in the table
+         Bucket* b1 = &buckets_[i1];
+         Bucket* b2 = &buckets_[i2];
+         if (const auto index = match_bucket(b1, key)) {
+            b1->payloads[index.value()] = payload;
+            return;
+         }
+         if (const auto index = match_bucket(b2, key)) {
+            b2->payloads[index.value()] = payload;
+            return;
+         }
+         if (unlikely(stash_count > 0)) {
+            for (size_t b = 0; b < StashBuckets; b++) {
+               if (const auto index = match_bucket(&stash[b], key)) {
+                  stash[b].payloads[index.value()] = payload;
+                  return;
+               }
+            }
+         }
+
+         struct Node {
+            size_t bucket_index;
+            size_t parent; // index into visited, None for the two roots
+            size_t parent_slot; // slot of the parent's bucket that was followed
+         };
+         std::vector<Node> visited;
+         visited.reserve(KickingFn::MaxScannedBuckets);
+         visited.push_back({i1, None, None});
+         visited.push_back({i2, None, None});
+
+         size_t found = None;
+         std::optional<size_t> hole_slot;
+         for (size_t head = 0; head < visited.size(); head++) {
+            if ((hole_slot = match_bucket(&buckets_[visited[head].bucket_index], Sentinel))) {
+               found = head;
+               break;
+            }
+
+            if (visited.size() + BucketSize > KickingFn::MaxScannedBuckets)
+               continue; // scan limit reached, drain the remaining queue
+            for (size_t i = 0; i < BucketSize; i++) {
+               const Key slot_key = buckets_[visited[head].bucket_index].keys[i];
+               visited.push_back({alternate_bucket(slot_key, visited[head].bucket_index), head, i});
+            }
+         }
+
+         if (unlikely(found == None)) {
+            stash_insert(key, payload);
+            return;
+         }
+
+         // shift entries backwards along the path, then place the new key in
+         // the freed slot of its candidate bucket
+         size_t hole = hole_slot.value();
+         size_t kicks = 0;
+         while (visited[found].parent != None) {
+            const auto& parent = visited[visited[found].parent];
+            Bucket& dst = buckets_[visited[found].bucket_index];
+            Bucket& src = buckets_[parent.bucket_index];
+            dst.keys[hole] = src.keys[visited[found].parent_slot];
+            dst.payloads[hole] = src.payloads[visited[found].parent_slot];
+            hole = visited[found].parent_slot;
+            found = visited[found].parent;
+            kicks++;
+         }
+         buckets_[visited[found].bucket_index].keys[hole] = key;
+         buckets_[visited[found].bucket_index].payloads[hole] = payload;
+
+         if constexpr (StatsMode::enabled) {
+            max_kick_cnt = std::max(max_kick_cnt, kicks);
+            total_kick_cnt += kicks > 0;
+         }
+      }
+   };
 } // namespace hashtable
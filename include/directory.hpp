@@ -0,0 +1,244 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Order important
+#include "convenience/builtins.hpp"
+
+namespace hashtable {
+   /**
+    * Process wide opt-in for huge page backed table storage. Large
+    * directories span millions of 4KiB pages, making dTLB misses a
+    * measurable fraction of every randomly addressed lookup; 2MiB pages
+    * cut the page count (and thereby the TLB pressure) by a factor of 512.
+    *
+    * When enabled, allocations of at least one huge page are served from
+    * anonymous mappings advised with MADV_HUGEPAGE. This is best effort:
+    * kernels without transparent huge pages simply ignore the advice and
+    * failed mappings fall back to the regular heap path. Toggle before
+    * constructing a table; existing tables keep the storage they were
+    * built with.
+    */
+   namespace huge_pages {
+      constexpr size_t Size = 2LLU << 20;
+
+      inline bool enabled = false;
+
+      /// bytes rounded up to the next huge page boundary
+      constexpr size_t round_up(const size_t& bytes) {
+         return (bytes + Size - 1) & ~(Size - 1);
+      }
+   } // namespace huge_pages
+
+   /**
+    * On disk header of a table snapshot. The directory data follows at the
+    * next page boundary, i.e., a restored table can serve lookups directly
+    * off the mapped file.
+    */
+   struct SnapshotHeader {
+      static constexpr uint64_t MagicValue = 0x50414e5331544858LLU; // "XHT1SNAP" (little endian)
+      static constexpr size_t TableNameLength = 64;
+      /// directory data offset within the snapshot file (page aligned)
+      static constexpr size_t DataOffset = 4096;
+
+      uint64_t magic = MagicValue;
+      uint64_t key_bytes = 0;
+      uint64_t payload_bytes = 0;
+      uint64_t bucket_bytes = 0;
+      uint64_t slots_per_bucket = 0;
+      uint64_t directory_count = 0;
+      /// Table::name(), truncated. Guards against restoring a snapshot into
+      /// an incompatible table type
+      char table_name[TableNameLength] = {0};
+   };
+
+   /**
+    * Fixed size bucket directory storage. Backed either by regular heap
+    * memory (respecting Bucket's alignment requirement), by an anonymous
+    * huge page mapping (see huge_pages::enabled), or, when restored from a
+    * snapshot, by a private copy-on-write mapping of the snapshot file:
+    * lookups are served straight from the page cache after a few page
+    * faults, modifications transparently copy the affected pages.
+    *
+    * NOTE: hash function state is not part of a snapshot. Restoring code
+    * must supply the same hash function the table was built with.
+    */
+   template<class Bucket>
+   class Directory {
+      Bucket* data_ = nullptr;
+      size_t size_ = 0;
+      void* mapping_ = nullptr; // non-null iff mmap backed (snapshot file or anonymous huge pages)
+      size_t mapping_bytes_ = 0;
+
+     public:
+      Directory() noexcept = default;
+
+      explicit Directory(const size_t& size) : size_(size) {
+         if (huge_pages::enabled && size * sizeof(Bucket) >= huge_pages::Size) {
+            const size_t bytes = huge_pages::round_up(size * sizeof(Bucket));
+            void* mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (likely(mapping != MAP_FAILED)) {
+#ifdef MADV_HUGEPAGE
+               madvise(mapping, bytes, MADV_HUGEPAGE);
+#endif
+               data_ = static_cast<Bucket*>(mapping);
+               for (size_t i = 0; i < size; i++)
+                  new (data_ + i) Bucket();
+               mapping_ = mapping;
+               mapping_bytes_ = bytes;
+               return;
+            }
+            // the kernel refused the mapping, fall back to the heap
+         }
+         data_ = new Bucket[size];
+      }
+
+      Directory(Directory&& other) noexcept
+         : data_(other.data_), size_(other.size_), mapping_(other.mapping_), mapping_bytes_(other.mapping_bytes_) {
+         other.data_ = nullptr;
+         other.size_ = 0;
+         other.mapping_ = nullptr;
+         other.mapping_bytes_ = 0;
+      }
+
+      Directory& operator=(Directory&& other) noexcept {
+         if (this != &other) {
+            release();
+            data_ = other.data_;
+            size_ = other.size_;
+            mapping_ = other.mapping_;
+            mapping_bytes_ = other.mapping_bytes_;
+            other.data_ = nullptr;
+            other.size_ = 0;
+            other.mapping_ = nullptr;
+            other.mapping_bytes_ = 0;
+         }
+         return *this;
+      }
+
+      Directory(const Directory&) = delete;
+      Directory& operator=(const Directory&) = delete;
+
+      ~Directory() {
+         release();
+      }
+
+      forceinline Bucket& operator[](const size_t& index) {
+         return data_[index];
+      }
+
+      forceinline const Bucket& operator[](const size_t& index) const {
+         return data_[index];
+      }
+
+      forceinline size_t size() const {
+         return size_;
+      }
+
+      /// bytes actually backing the directory, including any huge page
+      /// rounding or snapshot mapping overhead
+      forceinline size_t byte_size() const {
+         return mapping_ != nullptr ? mapping_bytes_ : size_ * sizeof(Bucket);
+      }
+
+      forceinline Bucket* begin() {
+         return data_;
+      }
+
+      forceinline Bucket* end() {
+         return data_ + size_;
+      }
+
+      forceinline const Bucket* begin() const {
+         return data_;
+      }
+
+      forceinline const Bucket* end() const {
+         return data_ + size_;
+      }
+
+      /**
+       * Serializes the directory to a snapshot file. header must carry the
+       * owning table's configuration (key/payload sizes, bucket size, name);
+       * sizes and magic are filled in here.
+       */
+      void save(const std::string& filepath, SnapshotHeader header) const {
+         header.magic = SnapshotHeader::MagicValue;
+         header.bucket_bytes = sizeof(Bucket);
+         header.directory_count = size_;
+
+         std::ofstream out(filepath, std::ios::binary | std::ios::trunc);
+         if (!out.is_open())
+            throw std::runtime_error("Failed to open snapshot file '" + filepath + "' for writing");
+
+         out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+         // pad to page boundary so the directory can be mapped in place
+         const std::string padding(SnapshotHeader::DataOffset - sizeof(header), '\0');
+         out.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+
+         out.write(reinterpret_cast<const char*>(data_), static_cast<std::streamsize>(size_ * sizeof(Bucket)));
+         if (!out)
+            throw std::runtime_error("Failed to write snapshot file '" + filepath + "'");
+      }
+
+      /**
+       * Restores a directory from a snapshot file previously written by
+       * save(), validating it against the expected table configuration.
+       */
+      static Directory from_snapshot(const std::string& filepath, const SnapshotHeader& expected) {
+         const int fd = open(filepath.c_str(), O_RDONLY);
+         if (fd < 0)
+            throw std::runtime_error("Failed to open snapshot file '" + filepath + "'");
+
+         struct stat file_stat {};
+         if (fstat(fd, &file_stat) < 0 || file_stat.st_size < static_cast<off_t>(SnapshotHeader::DataOffset)) {
+            close(fd);
+            throw std::runtime_error("Snapshot file '" + filepath + "' is truncated");
+         }
+         const size_t mapping_bytes = file_stat.st_size;
+
+         // private copy-on-write mapping: reads come straight from the page
+         // cache, writes copy the affected pages and never touch the file
+         void* mapping = mmap(nullptr, mapping_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+         close(fd);
+         if (mapping == MAP_FAILED)
+            throw std::runtime_error("Failed to mmap snapshot file '" + filepath + "'");
+
+         const auto* header = static_cast<const SnapshotHeader*>(mapping);
+         if (header->magic != SnapshotHeader::MagicValue || header->key_bytes != expected.key_bytes ||
+             header->payload_bytes != expected.payload_bytes || header->bucket_bytes != sizeof(Bucket) ||
+             header->slots_per_bucket != expected.slots_per_bucket ||
+             std::strncmp(header->table_name, expected.table_name, SnapshotHeader::TableNameLength) != 0 ||
+             SnapshotHeader::DataOffset + header->directory_count * sizeof(Bucket) > mapping_bytes) {
+            munmap(mapping, mapping_bytes);
+            throw std::runtime_error("Snapshot file '" + filepath + "' does not match the table configuration");
+         }
+
+         Directory directory;
+         directory.data_ = reinterpret_cast<Bucket*>(static_cast<char*>(mapping) + SnapshotHeader::DataOffset);
+         directory.size_ = header->directory_count;
+         directory.mapping_ = mapping;
+         directory.mapping_bytes_ = mapping_bytes;
+         return directory;
+      }
+
+     private:
+      void release() {
+         if (mapping_ != nullptr)
+            munmap(mapping_, mapping_bytes_);
+         else
+            delete[] data_;
+      }
+   };
+} // namespace hashtable
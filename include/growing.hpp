@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+
+#include "convenience/builtins.hpp"
+
+namespace hashtable {
+   /**
+    * Wraps any of the fixed capacity tables with incremental growth: once
+    * the fill level exceeds MaxLoadPercent, a second generation with twice
+    * the capacity is allocated and every subsequent insert migrates at most
+    * MigrationBatchSize old directory buckets (via the wrapped table's
+    * for_each_in_buckets()), i.e., no single operation ever pays the full
+    * O(n) rehash. maintain() migrates one batch without inserting, e.g., to
+    * drain a pending migration during idle periods.
+    *
+    * While a migration is in flight, lookups consult the new generation
+    * first and fall back to the old one. Already migrated entries briefly
+    * exist in both generations, which is harmless since keys are unique and
+    * their payloads immutable; inserts double check the old generation so
+    * duplicates cannot slip in. erase() is intentionally not exposed.
+    *
+    * NOTE: the new generation is built with a default constructed hash
+    * function, i.e., this wrapper is meant for stateless hash functions.
+    * Learned models trained on a fixed dataset cannot be grown this way.
+    */
+   template<class Table, size_t MigrationBatchSize = 64, size_t MaxLoadPercent = 80>
+   struct Growing {
+     public:
+      using KeyType = typename Table::KeyType;
+      using PayloadType = typename Table::PayloadType;
+
+      explicit Growing(const size_t& capacity)
+         : active(std::make_unique<Table>(capacity)), active_capacity(capacity) {}
+
+      Growing(Growing&&) noexcept = default;
+
+      /**
+       * Inserts a key, value/payload pair, triggering resp. advancing an
+       * incremental growth as necessary.
+       *
+       * @param key
+       * @param payload
+       * @return whether or not the key, payload pair was inserted. Insertion
+       *    will fail iff the same key already exists
+       */
+      bool insert(const KeyType& key, const PayloadType& payload) {
+         // the cuckoo tables' insert does not report duplicates, check
+         // explicitly so all wrapped tables behave uniformly
+         if constexpr (!std::is_same<decltype(active->insert(key, payload)), bool>::value) {
+            if (lookup(key).has_value())
+               return false;
+         }
+
+         if (next == nullptr && (stored + 1) * 100 > active_capacity * MaxLoadPercent)
+            begin_growth();
+
+         bool inserted;
+         if (next != nullptr) {
+            migrate_batch();
+
+            // the key might still reside in the old generation only (the
+            // new generation's insert detects migrated duplicates itself)
+            if (next != nullptr && active->lookup(key).has_value())
+               inserted = false;
+            else
+               inserted = insert_into(next != nullptr ? *next : *active, key, payload);
+         } else {
+            inserted = insert_into(*active, key, payload);
+         }
+
+         stored += inserted ? 1 : 0;
+         return inserted;
+      }
+
+      /**
+       * Retrieves the associated payload/value for a given key.
+       *
+       * @param key
+       * @return the payload or std::nullopt if key was not found in the Hashtable
+       */
+      std::optional<PayloadType> lookup(const KeyType& key) const {
+         if (next != nullptr) {
+            if (const auto payload = next->lookup(key))
+               return payload;
+         }
+
+         return active->lookup(key);
+      }
+
+      /**
+       * Migrates one bucket batch if a growth is in flight, e.g., to drain a
+       * pending migration during idle periods. Cheap no-op otherwise.
+       */
+      void maintain() {
+         if (next != nullptr)
+            migrate_batch();
+      }
+
+      /// whether a migration is currently in flight
+      bool growing() const {
+         return next != nullptr;
+      }
+
+      /// capacity of the currently active generation
+      size_t capacity() const {
+         return active_capacity;
+      }
+
+      size_t byte_size() const {
+         return sizeof(*this) + active->byte_size() + (next != nullptr ? next->byte_size() : 0);
+      }
+
+      static forceinline std::string name() {
+         return "growing_" + Table::name();
+      }
+
+      static forceinline std::string hash_name() {
+         return Table::hash_name();
+      }
+
+      static forceinline std::string reducer_name() {
+         return Table::reducer_name();
+      }
+
+      static constexpr forceinline size_t bucket_size() {
+         return Table::bucket_size();
+      }
+
+      static constexpr forceinline size_t directory_address_count(const size_t& capacity) {
+         return Table::directory_address_count(capacity);
+      }
+
+      /**
+       * Clears all keys from the hashtable, aborting any in flight
+       * migration. The capacity reached through growth is retained.
+       */
+      void clear() {
+         active->clear();
+         next.reset();
+         migrate_cursor = 0;
+         stored = 0;
+      }
+
+     private:
+      /// bridges the cuckoo tables' void returning insert
+      static forceinline bool insert_into(Table& table, const KeyType& key, const PayloadType& payload) {
+         if constexpr (std::is_same<decltype(table.insert(key, payload)), bool>::value) {
+            return table.insert(key, payload);
+         } else {
+            table.insert(key, payload);
+            return true;
+         }
+      }
+
+      void begin_growth() {
+         next = std::make_unique<Table>(active_capacity * 2);
+         migrate_cursor = 0;
+      }
+
+      void migrate_batch() {
+         const size_t total = Table::directory_address_count(active_capacity);
+         const size_t count = std::min(MigrationBatchSize, total - migrate_cursor);
+
+         active->for_each_in_buckets(migrate_cursor, count, [&](const KeyType& key, const PayloadType& payload) {
+            insert_into(*next, key, payload);
+         });
+         migrate_cursor += count;
+
+         if (migrate_cursor == total) {
+            active = std::move(next);
+            active_capacity *= 2;
+         }
+      }
+
+      /// current generation; during a migration this is the one being drained
+      std::unique_ptr<Table> active;
+
+      /// next generation, non-null iff a migration is in flight
+      std::unique_ptr<Table> next;
+
+      size_t active_capacity;
+
+      /// first active directory bucket that has not been migrated yet
+      size_t migrate_cursor = 0;
+
+      /// amount of currently stored entries
+      size_t stored = 0;
+   };
+} // namespace hashtable
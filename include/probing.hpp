@@ -1,12 +1,18 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
 #include <map>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <vector>
+#include <immintrin.h>
 
 #include "convenience/builtins.hpp"
+#include "directory.hpp"
+#include "reduction.hpp"
+#include "stats.hpp"
 #include "thirdparty/libdivide.h"
 
 namespace hashtable {
@@ -52,6 +58,60 @@ namespace hashtable {
       }
    };
 
+   /**
+    * LinearProbingFunc for power of two directories: wrap around is a
+    * single AND on the low bits instead of the conditional subtract.
+    * Selects the tables' power of two directory mode, see
+    * requires_pow2_directory.
+    */
+   struct MaskedLinearProbingFunc {
+     private:
+      const size_t mask;
+
+     public:
+      static constexpr bool pow2_directory = true;
+
+      MaskedLinearProbingFunc(const size_t& directory_size) : mask(directory_size - 1) {
+         if (unlikely((directory_size & (directory_size - 1)) != 0 || directory_size == 0))
+            throw std::runtime_error("masked probing requires a power of two directory size");
+      }
+
+      static std::string name() {
+         return "masked_linear";
+      }
+
+      forceinline size_t operator()(const size_t& index, const size_t& probing_step) const {
+         return (index + probing_step) & mask;
+      }
+   };
+
+   /**
+    * QuadraticProbingFunc for power of two directories: the libdivide
+    * multiply/shift sequence on every probe step collapses to a single AND.
+    * Selects the tables' power of two directory mode, see
+    * requires_pow2_directory.
+    */
+   struct MaskedQuadraticProbingFunc {
+     private:
+      const size_t mask;
+
+     public:
+      static constexpr bool pow2_directory = true;
+
+      MaskedQuadraticProbingFunc(const size_t& directory_size) : mask(directory_size - 1) {
+         if (unlikely((directory_size & (directory_size - 1)) != 0 || directory_size == 0))
+            throw std::runtime_error("masked probing requires a power of two directory size");
+      }
+
+      static std::string name() {
+         return "masked_quadratic";
+      }
+
+      forceinline size_t operator()(const size_t& index, const size_t& probing_step) const {
+         return (index + probing_step * probing_step) & mask;
+      }
+   };
+
    template<class Key,
             class Payload,
             class HashFn,
@@ -59,26 +119,77 @@ namespace hashtable {
             class ProbingFn,
             size_t MaxProbingSteps = 500,
             size_t BucketSize = 1,
+            class StatsMode = NoStats,
             Key Sentinel = std::numeric_limits<Key>::max()>
    struct Probing {
      public:
       using KeyType = Key;
       using PayloadType = Payload;
 
+     protected:
+      struct Bucket {
+         struct Slot {
+            Key key = Sentinel;
+            Payload payload;
+            /// marks a slot whose entry was erased. Lookups skip over
+            /// tombstones instead of early exiting, inserts may reuse them
+            bool tombstone = false;
+         } packed;
+
+         std::array<Slot, BucketSize> slots /*__attribute((aligned(sizeof(Key) * 8)))*/;
+      } packed;
+
      private:
       const HashFn hashfn;
       const ReductionFn reductionfn;
       const ProbingFn probingfn;
       const size_t capacity;
 
+      /// snapshot restore path, see save()
+      Probing(Directory<Bucket>&& directory, const HashFn& hashfn)
+         : hashfn(hashfn), reductionfn(ReductionFn(directory.size())), probingfn(ProbingFn(directory.size())),
+           capacity(directory.size() * BucketSize), buckets(std::move(directory)) {
+         // the displacement observed during the original build is not part of
+         // the snapshot. Fall back to the insert bound, which every stored
+         // entry is guaranteed to satisfy
+         max_displacement = MaxProbingSteps;
+      }
+
+      static SnapshotHeader snapshot_header() {
+         SnapshotHeader header;
+         header.key_bytes = sizeof(Key);
+         header.payload_bytes = sizeof(Payload);
+         header.slots_per_bucket = BucketSize;
+         std::strncpy(header.table_name, name().c_str(), SnapshotHeader::TableNameLength - 1);
+         return header;
+      }
+
      public:
       explicit Probing(const size_t& capacity, const HashFn hashfn = HashFn())
          : hashfn(hashfn), reductionfn(ReductionFn(directory_address_count(capacity))),
            probingfn(ProbingFn(directory_address_count(capacity))), capacity(capacity),
            buckets(directory_address_count(capacity)) {}
 
+      /**
+       * Restores a table from a snapshot file previously written by save().
+       * The directory is served directly off the mapped snapshot, i.e., a
+       * restarted process can answer lookups after a few page faults instead
+       * of a full rebuild. Hash function state is not serialized: the same
+       * hash function the table was originally built with must be supplied.
+       */
+      explicit Probing(const std::string& snapshot_filepath, const HashFn hashfn = HashFn())
+         : Probing(Directory<Bucket>::from_snapshot(snapshot_filepath, snapshot_header()), hashfn) {}
+
       Probing(Probing&&) noexcept = default;
 
+      /**
+       * Serializes the table's directory to a snapshot file which can later
+       * be restored with the snapshot constructor.
+       */
+      void save(const std::string& snapshot_filepath) const {
+         buckets.save(snapshot_filepath, snapshot_header());
+      }
+
       /**
        * Inserts a key, value/payload pair into the hashtable
        *
@@ -101,16 +212,37 @@ namespace hashtable {
          auto slot_index = orig_slot_index;
          size_t probing_step = 0;
 
+         // first tombstone along the probe path (reusable once the key is
+         // confirmed absent)
+         typename Bucket::Slot* free_slot = nullptr;
+         size_t free_slot_step = 0; // probing_step free_slot was found at
+
          for (;;) {
-            if (probing_step > MaxProbingSteps)
+            if (probing_step > MaxProbingSteps) {
+               if (free_slot != nullptr)
+                  break;
                throw std::runtime_error("Maximum probing step count (" + std::to_string(MaxProbingSteps) +
                                         ") exceeded");
+            }
 
             auto& bucket = buckets[slot_index];
             for (size_t i = 0; i < BucketSize; i++) {
                if (bucket.slots[i].key == Sentinel) {
-                  bucket.slots[i] = {.key = key, .payload = payload};
-                  return true;
+                  if (bucket.slots[i].tombstone) {
+                     // remember for reuse, but keep probing: the key might
+                     // still be stored further along the sequence
+                     if (free_slot == nullptr) {
+                        free_slot = &bucket.slots[i];
+                        free_slot_step = probing_step;
+                     }
+                     continue;
+                  }
+
+                  if (free_slot == nullptr) {
+                     free_slot = &bucket.slots[i];
+                     free_slot_step = probing_step;
+                  }
+                  goto place;
                } else if (bucket.slots[i].key == key) {
                   // key already exists
                   return false;
@@ -119,25 +251,41 @@ namespace hashtable {
 
             // Slot is full, choose a new slot index based on probing function
             slot_index = probingfn(orig_slot_index, ++probing_step);
-            if (unlikely(slot_index == orig_slot_index))
+            if (unlikely(slot_index == orig_slot_index)) {
+               if (free_slot != nullptr)
+                  break;
                throw std::runtime_error("Building " + this->name() +
                                         " failed: detected cycle during probing, all buckets along the way are full");
+            }
          }
+
+      place:
+         tombstone_count -= free_slot->tombstone ? 1 : 0;
+         *free_slot = {.key = key, .payload = payload};
+         max_displacement = std::max(max_displacement, probing_step);
+         if constexpr (StatsMode::enabled) {
+            stored_count++;
+            total_psl_ += free_slot_step;
+         }
+         return true;
       }
 
       /**
-       * Retrieves the associated payload/value for a given key.
+       * Removes a key from the hashtable by marking its slot as a tombstone,
+       * i.e., lookups skip over it while keeping their early exit on
+       * genuinely empty slots intact. Once tombstones make up more than an
+       * eighth of all slots the table is compacted (see compact()) so probe
+       * sequences do not degrade under churn.
        *
        * @param key
-       * @return the payload or std::nullopt if key was not found in the Hashtable
+       * @return whether or not the key was present and removed
        */
-      std::optional<Payload> lookup(const Key& key) const {
+      bool erase(const Key& key) {
          if (unlikely(key == Sentinel)) {
             assert(false); // TODO: this must never happen in practice
-            return std::nullopt;
+            return false;
          }
 
-         // Using template functor should successfully inline actual hash computation
          const auto orig_slot_index = reductionfn(hashfn(key));
          auto slot_index = orig_slot_index;
          size_t probing_step = 0;
@@ -145,21 +293,267 @@ namespace hashtable {
          for (;;) {
             auto& bucket = buckets[slot_index];
             for (size_t i = 0; i < BucketSize; i++) {
-               if (bucket.slots[i].key == key)
-                  return std::make_optional(bucket.slots[i].payload);
+               if (bucket.slots[i].key == key) {
+                  bucket.slots[i].key = Sentinel;
+                  bucket.slots[i].tombstone = true;
+                  tombstone_count++;
+                  if constexpr (StatsMode::enabled) {
+                     stored_count--;
+                     total_psl_ -= probing_step;
+                  }
 
-               if (bucket.slots[i].key == Sentinel)
-                  return std::nullopt;
+                  if (unlikely(tombstone_count * 8 > buckets.size() * BucketSize))
+                     compact();
+                  return true;
+               }
+
+               if (bucket.slots[i].key == Sentinel && !bucket.slots[i].tombstone)
+                  return false;
             }
 
-            // Slot is full, choose a new slot index based on probing function
             slot_index = probingfn(orig_slot_index, ++probing_step);
             if (unlikely(slot_index == orig_slot_index))
-               return std::nullopt;
+               return false;
+         }
+      }
+
+      /**
+       * Removes all tombstones by re-inserting every remaining element,
+       * restoring unobstructed probe sequences.
+       */
+      void compact() {
+         std::vector<std::pair<Key, Payload>> entries;
+         for (auto& bucket : buckets)
+            for (auto& slot : bucket.slots)
+               if (slot.key != Sentinel)
+                  entries.emplace_back(slot.key, slot.payload);
+
+         clear();
+         for (const auto& [key, payload] : entries)
+            insert(key, payload);
+      }
+
+      /**
+       * Retrieves the associated payload/value for a given key.
+       *
+       * @param key
+       * @return the payload or std::nullopt if key was not found in the Hashtable
+       */
+      std::optional<Payload> lookup(const Key& key) const {
+         if (unlikely(key == Sentinel)) {
+            assert(false); // TODO: this must never happen in practice
+            return std::nullopt;
+         }
+
+         // Using template functor should successfully inline actual hash computation
+         return lookup_from(reductionfn(hashfn(key)), key);
+      }
+
+      /**
+       * Retrieves the payloads for a batch of keys at once, overlapping the
+       * directory cache misses of the individual lookups: all hashes of a
+       * group are computed and their initial probe targets prefetched before
+       * the first probe sequence is resolved.
+       *
+       * Entries of out corresponding to keys that are not in the hashtable
+       * are left untouched.
+       *
+       * @param keys pointer to the first key of the batch
+       * @param n batch size
+       * @param out result array, n entries
+       * @return amount of keys that were found
+       */
+      size_t lookup_batch(const Key* keys, const size_t n, Payload* out) const {
+         constexpr size_t group_size = 16;
+         size_t slot_indices[group_size];
+         size_t found = 0;
+
+         for (size_t base = 0; base < n; base += group_size) {
+            const size_t group = std::min(group_size, n - base);
+
+            for (size_t j = 0; j < group; j++) {
+               slot_indices[j] = reductionfn(hashfn(keys[base + j]));
+               prefetch(&buckets[slot_indices[j]], 0, 1);
+            }
+
+            for (size_t j = 0; j < group; j++) {
+               if (const auto payload = lookup_from(slot_indices[j], keys[base + j])) {
+                  out[base + j] = payload.value();
+                  found++;
+               }
+            }
+         }
+
+         return found;
+      }
+      /**
+       * Retrieves the payloads for a batch of keys with AMAC-style software
+       * pipelining (asynchronous memory access chaining): up to InFlight
+       * probe state machines are live at any time, each suspending right
+       * after issuing the prefetch for its next directory access while the
+       * others advance, i.e., the dependent loads of a probe sequence are
+       * hidden behind independent work instead of stalling the core.
+       *
+       * Entries of out corresponding to keys that are not in the hashtable
+       * are left untouched.
+       *
+       * @param keys pointer to the first key of the batch
+       * @param n batch size
+       * @param out result array, n entries
+       * @return amount of keys that were found
+       */
+      template<size_t InFlight = 16>
+      size_t lookup_interleaved(const Key* keys, const size_t n, Payload* out) const {
+         struct Probe {
+            size_t key_index;
+            size_t orig_slot_index;
+            size_t slot_index;
+            size_t probing_step;
+         };
+
+         Probe probes[InFlight];
+         size_t active = 0; // probes[0..active) are in flight
+         size_t next_key = 0;
+         size_t found = 0;
+
+         const auto admit = [&](Probe& probe) {
+            probe.key_index = next_key++;
+            probe.orig_slot_index = reductionfn(hashfn(keys[probe.key_index]));
+            probe.slot_index = probe.orig_slot_index;
+            probe.probing_step = 0;
+            prefetch(&buckets[probe.slot_index], 0, 1);
+         };
+
+         while (active < InFlight && next_key < n)
+            admit(probes[active++]);
+
+         size_t cursor = 0;
+         while (active > 0) {
+            if (cursor >= active)
+               cursor = 0;
+            auto& probe = probes[cursor];
+
+            // resolve exactly one (by now hopefully cache resident) bucket
+            // of this probe's sequence
+            const auto& bucket = buckets[probe.slot_index];
+            bool done = false;
+            for (size_t i = 0; i < BucketSize; i++) {
+               const Key k = bucket.slots[i].key;
+               if (k == keys[probe.key_index]) {
+                  out[probe.key_index] = bucket.slots[i].payload;
+                  found++;
+                  done = true;
+                  break;
+               }
+
+               // tombstones must not terminate the probe sequence
+               if (k == Sentinel && !bucket.slots[i].tombstone) {
+                  done = true;
+                  break;
+               }
+            }
+
+            if (!done) {
+               probe.slot_index = probingfn(probe.orig_slot_index, ++probe.probing_step);
+               if (likely(probe.slot_index != probe.orig_slot_index)) {
+                  // suspend: prefetch the next bucket, switch to another probe
+                  prefetch(&buckets[probe.slot_index], 0, 1);
+                  cursor++;
+                  continue;
+               }
+            }
+
+            // retire: hand this state machine the next key (if any)
+            if (next_key < n) {
+               admit(probe);
+               cursor++;
+            } else {
+               probe = probes[--active];
+            }
+         }
+
+         return found;
+      }
+
+      /**
+       * Retrieves the payloads associated with keys within [min, max].
+       *
+       * NOTE: this function will only return sensible results if the employed
+       * hash function is monotone, in which case the range's keys occupy the
+       * contiguous directory region between the two bounds' buckets, plus at
+       * most the maximum displacement any insert has produced so far. The
+       * scan walks that region sequentially, i.e., it is served by the
+       * hardware prefetcher instead of issuing a probe sequence per key.
+       *
+       * @param min minimum key value (inclusive)
+       * @param max maximum key value (inclusive)
+       * @return a vector of payloads associated with keys within the range, if
+       *   any exist. Otherwise empty.
+       */
+      std::vector<Payload> lookup_range(const Key& min, const Key& max) const {
+         if (unlikely(min == Sentinel || max == Sentinel)) {
+            assert(false); // TODO: this must never happen in practice
+            return {};
+         }
+
+         const auto lower_bound_index = reductionfn(hashfn(min));
+         const auto upper_bound_index = reductionfn(hashfn(max));
+
+         std::vector<Payload> result;
+
+         // non monotone hash order violation
+         if (unlikely(upper_bound_index < lower_bound_index))
+            return result;
+
+         // displaced entries sit at most max_displacement buckets beyond
+         // their home bucket; clamp to a single directory sweep
+         const size_t scan_buckets =
+            std::min(upper_bound_index - lower_bound_index + 1 + max_displacement, buckets.size());
+
+         auto slot_index = lower_bound_index;
+         for (size_t step = 0; step < scan_buckets; step++) {
+            const auto& bucket = buckets[slot_index];
+            for (size_t i = 0; i < BucketSize; i++) {
+               const Key k = bucket.slots[i].key;
+               // tombstones carry the Sentinel key, i.e., they never match
+               if (k >= min && k <= max)
+                  result.push_back(bucket.slots[i].payload);
+            }
+
+            slot_index = slot_index + 1 == buckets.size() ? 0 : slot_index + 1;
+         }
+
+         return result;
+      }
+
+      /**
+       * Invokes f(key, payload) for every entry physically stored in the
+       * directory bucket range [from, from + n), e.g., to migrate entries
+       * during an incremental resize (see Growing).
+       */
+      template<class F>
+      void for_each_in_buckets(const size_t& from, const size_t& n, F f) const {
+         for (size_t b = from; b < from + n; b++) {
+            const auto& bucket = buckets[b];
+            for (size_t i = 0; i < BucketSize; i++)
+               if (bucket.slots[i].key != Sentinel)
+                  f(bucket.slots[i].key, bucket.slots[i].payload);
          }
       }
 
       std::map<std::string, double> lookup_statistics(const std::vector<Key>& dataset) {
+         if constexpr (StatsMode::enabled) {
+            // O(1) read of the incrementally maintained counters
+            UNUSED(dataset);
+            return {{"stored", stored_count},
+                    {"tombstones", tombstone_count},
+                    {"max_psl", max_displacement},
+                    {"total_psl", total_psl_},
+                    {"average_psl",
+                     stored_count == 0 ? 0.0
+                                       : static_cast<double>(total_psl_) / static_cast<double>(stored_count)}};
+         }
+
          size_t min_psl = 0, max_psl = 0, total_psl = 0;
          long double average_psl = 0;
 
@@ -180,7 +574,7 @@ namespace hashtable {
                      goto next;
                   }
 
-                  if (bucket.slots[i].key == Sentinel)
+                  if (bucket.slots[i].key == Sentinel && !bucket.slots[i].tombstone)
                      goto next;
                }
 
@@ -200,7 +594,7 @@ namespace hashtable {
       }
 
       size_t byte_size() const {
-         return sizeof(*this) + buckets.size() * bucket_byte_size();
+         return sizeof(*this) + buckets.byte_size();
       }
 
       static constexpr forceinline size_t bucket_byte_size() {
@@ -208,7 +602,7 @@ namespace hashtable {
       }
 
       static forceinline std::string name() {
-         return ProbingFn::name() + "_probing";
+         return ProbingFn::name() + "_probing" + (StatsMode::enabled ? "_" + StatsMode::name() : "");
       }
 
       static forceinline std::string hash_name() {
@@ -224,6 +618,9 @@ namespace hashtable {
       }
 
       static constexpr forceinline size_t directory_address_count(const size_t& capacity) {
+         // power of two directory mode, see requires_pow2_directory
+         if constexpr (requires_pow2_directory<ReductionFn>::value || requires_pow2_directory<ProbingFn>::value)
+            return next_pow2((capacity + BucketSize - 1) / BucketSize);
          return (capacity + BucketSize - 1) / BucketSize;
       }
 
@@ -235,8 +632,15 @@ namespace hashtable {
          for (auto& bucket : buckets) {
             for (auto& slot : bucket.slots) {
                slot.key = Sentinel;
+               slot.tombstone = false;
             }
          }
+         tombstone_count = 0;
+         max_displacement = 0;
+         if constexpr (StatsMode::enabled) {
+            stored_count = 0;
+            total_psl_ = 0;
+         }
       }
 
       ~Probing() {
@@ -244,16 +648,74 @@ namespace hashtable {
       }
 
      protected:
-      struct Bucket {
-         struct Slot {
-            Key key = Sentinel;
-            Payload payload;
-         } packed;
+      /**
+       * Resolves a lookup starting from an already computed initial slot
+       * index, following the probing sequence until the key or an empty slot
+       * is found.
+       */
+      forceinline std::optional<Payload> lookup_from(const size_t& orig_slot_index, const Key& key) const {
+         auto slot_index = orig_slot_index;
+         size_t probing_step = 0;
 
-         std::array<Slot, BucketSize> slots /*__attribute((aligned(sizeof(Key) * 8)))*/;
-      } packed;
+         for (;;) {
+            auto& bucket = buckets[slot_index];
+            if constexpr (BucketSize == 1) {
+               // single slot fast path: one load feeding two compares, no
+               // inner loop bookkeeping
+               const auto& slot = bucket.slots[0];
+               if (slot.key == key)
+                  return std::make_optional(slot.payload);
+
+               // tombstones must not terminate the probe sequence
+               if (slot.key == Sentinel && !slot.tombstone)
+                  return std::nullopt;
+            } else if constexpr (BucketSize <= 8) {
+               // fully unrolled branch free compare chain: resolve all slots
+               // before branching once. Entries never sit behind a genuinely
+               // empty slot of the same bucket (insert would have claimed
+               // it), i.e., deferring the empty check past the matches is
+               // safe
+               size_t match_i = BucketSize;
+               size_t empty_i = BucketSize;
+               for (size_t i = BucketSize; i-- > 0;) {
+                  match_i = bucket.slots[i].key == key ? i : match_i;
+                  empty_i = bucket.slots[i].key == Sentinel && !bucket.slots[i].tombstone ? i : empty_i;
+               }
+
+               if (match_i < BucketSize)
+                  return std::make_optional(bucket.slots[match_i].payload);
+               if (empty_i < BucketSize)
+                  return std::nullopt;
+            } else {
+               for (size_t i = 0; i < BucketSize; i++) {
+                  if (bucket.slots[i].key == key)
+                     return std::make_optional(bucket.slots[i].payload);
+
+                  // tombstones must not terminate the probe sequence
+                  if (bucket.slots[i].key == Sentinel && !bucket.slots[i].tombstone)
+                     return std::nullopt;
+               }
+            }
+
+            // Slot is full, choose a new slot index based on probing function
+            slot_index = probingfn(orig_slot_index, ++probing_step);
+            if (unlikely(slot_index == orig_slot_index))
+               return std::nullopt;
+         }
+      }
 
-      std::vector<Bucket> buckets;
+      Directory<Bucket> buckets;
+
+      size_t tombstone_count = 0;
+
+      /// largest probing_step any insert placed an entry at, bounds the
+      /// overscan of lookup_range()
+      size_t max_displacement = 0;
+
+      /// incremental statistics, only maintained when StatsMode::enabled
+      /// (see lookup_statistics())
+      size_t stored_count = 0;
+      size_t total_psl_ = 0;
    };
 
    template<class Key,
@@ -262,26 +724,75 @@ namespace hashtable {
             class ReductionFn,
             class ProbingFn,
             size_t BucketSize = 1,
+            class StatsMode = NoStats,
             Key Sentinel = std::numeric_limits<Key>::max()>
    struct RobinhoodProbing {
      public:
       using KeyType = Key;
       using PayloadType = Payload;
 
+     protected:
+      struct Bucket {
+         struct Slot {
+            Key key = Sentinel;
+            Payload payload;
+            size_t psl = 0;
+         } packed;
+
+         std::array<Slot, BucketSize> slots /*__attribute((aligned(sizeof(Key) * 8)))*/;
+      } packed;
+
      private:
       const HashFn hashfn;
       const ReductionFn reductionfn;
       const ProbingFn probingfn;
       const size_t capacity;
 
+      /// snapshot restore path, see save()
+      RobinhoodProbing(Directory<Bucket>&& directory, const HashFn& hashfn)
+         : hashfn(hashfn), reductionfn(ReductionFn(directory.size())), probingfn(ProbingFn(directory.size())),
+           capacity(directory.size() * BucketSize), buckets(std::move(directory)) {
+         // the displacement observed during the original build is not part of
+         // the snapshot and recomputing it would fault in the entire mapping.
+         // Fall back to a full directory sweep, which is always safe
+         max_displacement = buckets.size();
+      }
+
+      static SnapshotHeader snapshot_header() {
+         SnapshotHeader header;
+         header.key_bytes = sizeof(Key);
+         header.payload_bytes = sizeof(Payload);
+         header.slots_per_bucket = BucketSize;
+         std::strncpy(header.table_name, name().c_str(), SnapshotHeader::TableNameLength - 1);
+         return header;
+      }
+
      public:
       explicit RobinhoodProbing(const size_t& capacity, const HashFn hashfn = HashFn())
          : hashfn(hashfn), reductionfn(ReductionFn(directory_address_count(capacity))),
            probingfn(ProbingFn(directory_address_count(capacity))), capacity(capacity),
            buckets(directory_address_count(capacity)) {}
 
+      /**
+       * Restores a table from a snapshot file previously written by save().
+       * The directory is served directly off the mapped snapshot, i.e., a
+       * restarted process can answer lookups after a few page faults instead
+       * of a full rebuild. Hash function state is not serialized: the same
+       * hash function the table was originally built with must be supplied.
+       */
+      explicit RobinhoodProbing(const std::string& snapshot_filepath, const HashFn hashfn = HashFn())
+         : RobinhoodProbing(Directory<Bucket>::from_snapshot(snapshot_filepath, snapshot_header()), hashfn) {}
+
       RobinhoodProbing(RobinhoodProbing&&) noexcept = default;
 
+      /**
+       * Serializes the table's directory to a snapshot file which can later
+       * be restored with the snapshot constructor.
+       */
+      void save(const std::string& snapshot_filepath) const {
+         buckets.save(snapshot_filepath, snapshot_header());
+      }
+
       /**
        * Inserts a key, value/payload pair into the hashtable
        *
@@ -315,6 +826,11 @@ namespace hashtable {
             for (size_t i = 0; i < BucketSize; i++) {
                if (bucket.slots[i].key == Sentinel) {
                   bucket.slots[i] = {.key = key, .payload = payload, .psl = probing_step};
+                  max_displacement = std::max(max_displacement, probing_step);
+                  if constexpr (StatsMode::enabled) {
+                     stored_count++;
+                     total_psl_ += probing_step;
+                  }
                   return true;
                } else if (bucket.slots[i].key == key) {
                   // key already exists
@@ -326,6 +842,11 @@ namespace hashtable {
                      throw std::runtime_error("insertion failed, infinite loop detected");
 
                   bucket.slots[i] = {.key = key, .payload = payload, .psl = probing_step};
+                  max_displacement = std::max(max_displacement, probing_step);
+                  // the displaced rich entry keeps probing from its old psl,
+                  // i.e., only the net displacement change is accounted here
+                  if constexpr (StatsMode::enabled)
+                     total_psl_ += probing_step - rich_slot.psl;
 
                   key = rich_slot.key;
                   payload = rich_slot.payload;
@@ -346,81 +867,270 @@ namespace hashtable {
       }
 
       /**
-       * Retrieves the associated payload/value for a given key.
+       * Removes a key from the hashtable using backward-shift deletion: the
+       * psl fields identify displaced entries in subsequent buckets, which
+       * are moved back into the hole. No tombstones are required and
+       * lookup's early exit on empty slots remains correct.
+       *
+       * NOTE: only available for linear probing, where every displaced
+       * entry's probe sequence is known to pass through the preceding
+       * bucket.
        *
        * @param key
-       * @return the payload or std::nullopt if key was not found in the Hashtable
+       * @return whether or not the key was present and removed
        */
-      std::optional<Payload> lookup(const Key& key) const {
+      bool erase(const Key& key) {
+         static_assert(std::is_same<ProbingFn, LinearProbingFunc>::value,
+                       "backward-shift deletion is only correct for linear probing");
+
          if (unlikely(key == Sentinel)) {
             assert(false); // TODO: this must never happen in practice
-            return std::nullopt;
+            return false;
          }
 
-         // Using template functor should successfully inline actual hash computation
          const auto orig_slot_index = reductionfn(hashfn(key));
          auto slot_index = orig_slot_index;
          size_t probing_step = 0;
+         size_t hole = BucketSize;
 
+         // locate the key
          for (;;) {
             auto& bucket = buckets[slot_index];
             for (size_t i = 0; i < BucketSize; i++) {
-               if (bucket.slots[i].key == key)
-                  return std::make_optional(bucket.slots[i].payload);
+               if (bucket.slots[i].key == key) {
+                  hole = i;
+                  if constexpr (StatsMode::enabled) {
+                     stored_count--;
+                     total_psl_ -= bucket.slots[i].psl;
+                  }
+                  break;
+               }
 
                if (bucket.slots[i].key == Sentinel)
-                  return std::nullopt;
+                  return false;
             }
+            if (hole != BucketSize)
+               break;
 
-            // Slot is full, choose a new slot index based on probing function
             slot_index = probingfn(orig_slot_index, ++probing_step);
             if (unlikely(slot_index == orig_slot_index))
-               return std::nullopt;
+               return false;
          }
-      }
-
-      std::map<std::string, double> lookup_statistics(const std::vector<Key>& dataset) {
-         size_t min_psl = 0, max_psl = 0, total_psl = 0;
-         long double average_psl = 0;
-
-         for (const auto& key : dataset) {
-            // Using template functor should successfully inline actual hash computation
-            const auto orig_slot_index = reductionfn(hashfn(key));
-            auto slot_index = orig_slot_index;
-            size_t probing_step = 0;
 
-            for (;;) {
-               auto& bucket = buckets[slot_index];
-               for (size_t i = 0; i < BucketSize; i++) {
-                  if (bucket.slots[i].key == key) {
-                     min_psl = std::min(min_psl, probing_step);
-                     max_psl = std::max(max_psl, probing_step);
-                     total_psl += probing_step;
-                     average_psl += static_cast<long double>(probing_step);
-                     goto next;
-                  }
+         for (;;) {
+            auto& bucket = buckets[slot_index];
 
-                  if (bucket.slots[i].key == Sentinel)
-                     goto next;
+            // keep the bucket densely packed: move its last occupied entry
+            // into the hole (lookup early exits on the first empty slot)
+            size_t last = hole;
+            while (last + 1 < BucketSize && bucket.slots[last + 1].key != Sentinel)
+               last++;
+            if (last != hole) {
+               bucket.slots[hole] = bucket.slots[last];
+               hole = last;
+            }
+            bucket.slots[hole] = {};
+
+            // backward-shift: pull a displaced entry (psl > 0, i.e., its
+            // probe sequence passed through this bucket) out of the next
+            // bucket and repeat there. Once no bucket entry is displaced,
+            // no key further along can pass through the hole either.
+            const size_t next_index = slot_index + 1 == buckets.size() ? 0 : slot_index + 1;
+            if (unlikely(next_index == slot_index))
+               return true;
+
+            auto& next = buckets[next_index];
+            size_t victim = BucketSize;
+            for (size_t i = 0; i < BucketSize && next.slots[i].key != Sentinel; i++) {
+               if (next.slots[i].psl > 0) {
+                  victim = i;
+                  break;
                }
-
-               // Slot is full, choose a new slot index based on probing function
-               slot_index = probingfn(orig_slot_index, ++probing_step);
-               if (unlikely(slot_index == orig_slot_index))
-                  goto next;
             }
-
-         next:
-            continue;
+            if (victim == BucketSize)
+               return true;
+
+            bucket.slots[hole] = next.slots[victim];
+            bucket.slots[hole].psl--;
+            if constexpr (StatsMode::enabled)
+               total_psl_--;
+            hole = victim;
+            slot_index = next_index;
          }
+      }
 
-         average_psl /= static_cast<long double>(dataset.size());
+      /**
+       * Retrieves the associated payload/value for a given key.
+       *
+       * @param key
+       * @return the payload or std::nullopt if key was not found in the Hashtable
+       */
+      std::optional<Payload> lookup(const Key& key) const {
+         if (unlikely(key == Sentinel)) {
+            assert(false); // TODO: this must never happen in practice
+            return std::nullopt;
+         }
+
+         // Using template functor should successfully inline actual hash computation
+         return lookup_from(reductionfn(hashfn(key)), key);
+      }
+
+      /**
+       * Retrieves the payloads for a batch of keys at once, overlapping the
+       * directory cache misses of the individual lookups: all hashes of a
+       * group are computed and their initial probe targets prefetched before
+       * the first probe sequence is resolved.
+       *
+       * Entries of out corresponding to keys that are not in the hashtable
+       * are left untouched.
+       *
+       * @param keys pointer to the first key of the batch
+       * @param n batch size
+       * @param out result array, n entries
+       * @return amount of keys that were found
+       */
+      size_t lookup_batch(const Key* keys, const size_t n, Payload* out) const {
+         constexpr size_t group_size = 16;
+         size_t slot_indices[group_size];
+         size_t found = 0;
+
+         for (size_t base = 0; base < n; base += group_size) {
+            const size_t group = std::min(group_size, n - base);
+
+            for (size_t j = 0; j < group; j++) {
+               slot_indices[j] = reductionfn(hashfn(keys[base + j]));
+               prefetch(&buckets[slot_indices[j]], 0, 1);
+            }
+
+            for (size_t j = 0; j < group; j++) {
+               if (const auto payload = lookup_from(slot_indices[j], keys[base + j])) {
+                  out[base + j] = payload.value();
+                  found++;
+               }
+            }
+         }
+
+         return found;
+      }
+
+      /**
+       * Retrieves the payloads associated with keys within [min, max].
+       *
+       * NOTE: this function will only return sensible results if the employed
+       * hash function is monotone, in which case the range's keys occupy the
+       * contiguous directory region between the two bounds' buckets, plus at
+       * most the maximum displacement any insert has produced so far. The
+       * scan walks that region sequentially, i.e., it is served by the
+       * hardware prefetcher instead of issuing a probe sequence per key.
+       *
+       * @param min minimum key value (inclusive)
+       * @param max maximum key value (inclusive)
+       * @return a vector of payloads associated with keys within the range, if
+       *   any exist. Otherwise empty.
+       */
+      std::vector<Payload> lookup_range(const Key& min, const Key& max) const {
+         if (unlikely(min == Sentinel || max == Sentinel)) {
+            assert(false); // TODO: this must never happen in practice
+            return {};
+         }
+
+         const auto lower_bound_index = reductionfn(hashfn(min));
+         const auto upper_bound_index = reductionfn(hashfn(max));
+
+         std::vector<Payload> result;
+
+         // non monotone hash order violation
+         if (unlikely(upper_bound_index < lower_bound_index))
+            return result;
+
+         // displaced entries sit at most max_displacement buckets beyond
+         // their home bucket; clamp to a single directory sweep
+         const size_t scan_buckets =
+            std::min(upper_bound_index - lower_bound_index + 1 + max_displacement, buckets.size());
+
+         auto slot_index = lower_bound_index;
+         for (size_t step = 0; step < scan_buckets; step++) {
+            const auto& bucket = buckets[slot_index];
+            for (size_t i = 0; i < BucketSize; i++) {
+               const Key k = bucket.slots[i].key;
+               if (k >= min && k <= max)
+                  result.push_back(bucket.slots[i].payload);
+            }
+
+            slot_index = slot_index + 1 == buckets.size() ? 0 : slot_index + 1;
+         }
+
+         return result;
+      }
+
+      /**
+       * Invokes f(key, payload) for every entry physically stored in the
+       * directory bucket range [from, from + n), e.g., to migrate entries
+       * during an incremental resize (see Growing).
+       */
+      template<class F>
+      void for_each_in_buckets(const size_t& from, const size_t& n, F f) const {
+         for (size_t b = from; b < from + n; b++) {
+            const auto& bucket = buckets[b];
+            for (size_t i = 0; i < BucketSize; i++)
+               if (bucket.slots[i].key != Sentinel)
+                  f(bucket.slots[i].key, bucket.slots[i].payload);
+         }
+      }
+
+      std::map<std::string, double> lookup_statistics(const std::vector<Key>& dataset) {
+         if constexpr (StatsMode::enabled) {
+            // O(1) read of the incrementally maintained counters
+            UNUSED(dataset);
+            return {{"stored", stored_count},
+                    {"max_psl", max_displacement},
+                    {"total_psl", total_psl_},
+                    {"average_psl",
+                     stored_count == 0 ? 0.0
+                                       : static_cast<double>(total_psl_) / static_cast<double>(stored_count)}};
+         }
+
+         size_t min_psl = 0, max_psl = 0, total_psl = 0;
+         long double average_psl = 0;
+
+         for (const auto& key : dataset) {
+            // Using template functor should successfully inline actual hash computation
+            const auto orig_slot_index = reductionfn(hashfn(key));
+            auto slot_index = orig_slot_index;
+            size_t probing_step = 0;
+
+            for (;;) {
+               auto& bucket = buckets[slot_index];
+               for (size_t i = 0; i < BucketSize; i++) {
+                  if (bucket.slots[i].key == key) {
+                     min_psl = std::min(min_psl, probing_step);
+                     max_psl = std::max(max_psl, probing_step);
+                     total_psl += probing_step;
+                     average_psl += static_cast<long double>(probing_step);
+                     goto next;
+                  }
+
+                  if (bucket.slots[i].key == Sentinel)
+                     goto next;
+               }
+
+               // Slot is full, choose a new slot index based on probing function
+               slot_index = probingfn(orig_slot_index, ++probing_step);
+               if (unlikely(slot_index == orig_slot_index))
+                  goto next;
+            }
+
+         next:
+            continue;
+         }
+
+         average_psl /= static_cast<long double>(dataset.size());
 
          return {{"min_psl", min_psl}, {"max_psl", max_psl}, {"average_psl", average_psl}, {"total_psl", total_psl}};
       }
 
       size_t byte_size() const {
-         return sizeof(*this) + buckets.size() * bucket_byte_size();
+         return sizeof(*this) + buckets.byte_size();
       }
 
       static constexpr forceinline size_t bucket_byte_size() {
@@ -428,7 +1138,7 @@ namespace hashtable {
       }
 
       static forceinline std::string name() {
-         return ProbingFn::name() + "_robinhood_probing";
+         return ProbingFn::name() + "_robinhood_probing" + (StatsMode::enabled ? "_" + StatsMode::name() : "");
       }
 
       static forceinline std::string hash_name() {
@@ -444,6 +1154,9 @@ namespace hashtable {
       }
 
       static constexpr forceinline size_t directory_address_count(const size_t& capacity) {
+         // power of two directory mode, see requires_pow2_directory
+         if constexpr (requires_pow2_directory<ReductionFn>::value || requires_pow2_directory<ProbingFn>::value)
+            return next_pow2((capacity + BucketSize - 1) / BucketSize);
          return (capacity + BucketSize - 1) / BucketSize;
       }
 
@@ -457,6 +1170,11 @@ namespace hashtable {
                slot.key = Sentinel;
             }
          }
+         max_displacement = 0;
+         if constexpr (StatsMode::enabled) {
+            stored_count = 0;
+            total_psl_ = 0;
+         }
       }
 
       ~RobinhoodProbing() {
@@ -464,16 +1182,668 @@ namespace hashtable {
       }
 
      protected:
-      struct Bucket {
-         struct Slot {
-            Key key = Sentinel;
-            Payload payload;
-            size_t psl = 0;
-         } packed;
+      /**
+       * Resolves a lookup starting from an already computed initial slot
+       * index, following the probing sequence until the key or an empty slot
+       * is found.
+       */
+      forceinline std::optional<Payload> lookup_from(const size_t& orig_slot_index, const Key& key) const {
+         auto slot_index = orig_slot_index;
+         size_t probing_step = 0;
 
-         std::array<Slot, BucketSize> slots /*__attribute((aligned(sizeof(Key) * 8)))*/;
-      } packed;
+         for (;;) {
+            auto& bucket = buckets[slot_index];
+            if constexpr (BucketSize == 1) {
+               // single slot fast path: one load feeding two compares, no
+               // inner loop bookkeeping
+               const auto& slot = bucket.slots[0];
+               if (slot.key == key)
+                  return std::make_optional(slot.payload);
+
+               if (slot.key == Sentinel)
+                  return std::nullopt;
+            } else if constexpr (BucketSize <= 8) {
+               // fully unrolled branch free compare chain, see
+               // Probing::lookup_from
+               size_t match_i = BucketSize;
+               size_t empty_i = BucketSize;
+               for (size_t i = BucketSize; i-- > 0;) {
+                  match_i = bucket.slots[i].key == key ? i : match_i;
+                  empty_i = bucket.slots[i].key == Sentinel ? i : empty_i;
+               }
+
+               if (match_i < BucketSize)
+                  return std::make_optional(bucket.slots[match_i].payload);
+               if (empty_i < BucketSize)
+                  return std::nullopt;
+            } else {
+               for (size_t i = 0; i < BucketSize; i++) {
+                  if (bucket.slots[i].key == key)
+                     return std::make_optional(bucket.slots[i].payload);
+
+                  if (bucket.slots[i].key == Sentinel)
+                     return std::nullopt;
+               }
+            }
+
+            // Slot is full, choose a new slot index based on probing function
+            slot_index = probingfn(orig_slot_index, ++probing_step);
+            if (unlikely(slot_index == orig_slot_index))
+               return std::nullopt;
+         }
+      }
+
+      Directory<Bucket> buckets;
+
+      /// largest psl any insert placed an entry at, bounds the overscan of
+      /// lookup_range()
+      size_t max_displacement = 0;
+
+      /// incremental statistics, only maintained when StatsMode::enabled
+      /// (see lookup_statistics())
+      size_t stored_count = 0;
+      size_t total_psl_ = 0;
+   };
+
+   /**
+    * Probing variant keeping keys and payloads in separate contiguous arrays
+    * (struct of arrays): probe steps touch the key array only, i.e., a cache
+    * line holds twice as many candidate keys as with Probing's interleaved
+    * slots, and the payload is fetched just once on a confirmed match.
+    * Particularly beneficial for negative-lookup heavy workloads, where most
+    * probed slots never produce a match.
+    */
+   template<class Key,
+            class Payload,
+            class HashFn,
+            class ReductionFn,
+            class ProbingFn,
+            size_t MaxProbingSteps = 500,
+            size_t BucketSize = 1,
+            Key Sentinel = std::numeric_limits<Key>::max()>
+   struct SoAProbing {
+     public:
+      using KeyType = Key;
+      using PayloadType = Payload;
+
+     protected:
+      struct KeyBucket {
+         std::array<Key, BucketSize> keys;
+
+         KeyBucket() {
+            keys.fill(Sentinel);
+         }
+      };
+
+      struct PayloadBucket {
+         std::array<Payload, BucketSize> payloads;
+      };
+
+     private:
+      const HashFn hashfn;
+      const ReductionFn reductionfn;
+      const ProbingFn probingfn;
+      const size_t capacity;
+
+     public:
+      explicit SoAProbing(const size_t& capacity, const HashFn hashfn = HashFn())
+         : hashfn(hashfn), reductionfn(ReductionFn(directory_address_count(capacity))),
+           probingfn(ProbingFn(directory_address_count(capacity))), capacity(capacity),
+           keys(directory_address_count(capacity)), payloads(directory_address_count(capacity)) {}
+
+      SoAProbing(SoAProbing&&) noexcept = default;
+
+      /**
+       * Inserts a key, value/payload pair into the hashtable
+       *
+       * Note: Will throw a runtime error iff the probing function produces a
+       * cycle and all buckets along that cycle are full.
+       *
+       * @param key
+       * @param payload
+       * @return whether or not the key, payload pair was inserted. Insertion will fail
+       *    iff the same key already exists or if key == Sentinel value
+       */
+      bool insert(const Key& key, const Payload payload) {
+         if (unlikely(key == Sentinel)) {
+            assert(false); // TODO: this must never happen in practice
+            return false;
+         }
+
+         // Using template functor should successfully inline actual hash computation
+         const auto orig_slot_index = reductionfn(hashfn(key));
+         auto slot_index = orig_slot_index;
+         size_t probing_step = 0;
+
+         for (;;) {
+            if (probing_step > MaxProbingSteps)
+               throw std::runtime_error("Maximum probing step count (" + std::to_string(MaxProbingSteps) +
+                                        ") exceeded");
+
+            auto& bucket = keys[slot_index];
+            for (size_t i = 0; i < BucketSize; i++) {
+               if (bucket.keys[i] == Sentinel) {
+                  bucket.keys[i] = key;
+                  payloads[slot_index].payloads[i] = payload;
+                  return true;
+               } else if (bucket.keys[i] == key) {
+                  // key already exists
+                  return false;
+               }
+            }
+
+            // Slot is full, choose a new slot index based on probing function
+            slot_index = probingfn(orig_slot_index, ++probing_step);
+            if (unlikely(slot_index == orig_slot_index))
+               throw std::runtime_error("Building " + this->name() +
+                                        " failed: detected cycle during probing, all buckets along the way are full");
+         }
+      }
+
+      /**
+       * Retrieves the associated payload/value for a given key.
+       *
+       * @param key
+       * @return the payload or std::nullopt if key was not found in the Hashtable
+       */
+      std::optional<Payload> lookup(const Key& key) const {
+         if (unlikely(key == Sentinel)) {
+            assert(false); // TODO: this must never happen in practice
+            return std::nullopt;
+         }
+
+         // Using template functor should successfully inline actual hash computation
+         return lookup_from(reductionfn(hashfn(key)), key);
+      }
+
+      /**
+       * Retrieves the payloads for a batch of keys at once, overlapping the
+       * directory cache misses of the individual lookups: all hashes of a
+       * group are computed and their initial probe targets prefetched before
+       * the first probe sequence is resolved. Only the key array is
+       * prefetched - payloads are touched on confirmed matches exclusively.
+       *
+       * Entries of out corresponding to keys that are not in the hashtable
+       * are left untouched.
+       *
+       * @param keys_in pointer to the first key of the batch
+       * @param n batch size
+       * @param out result array, n entries
+       * @return amount of keys that were found
+       */
+      size_t lookup_batch(const Key* keys_in, const size_t n, Payload* out) const {
+         constexpr size_t group_size = 16;
+         size_t slot_indices[group_size];
+         size_t found = 0;
+
+         for (size_t base = 0; base < n; base += group_size) {
+            const size_t group = std::min(group_size, n - base);
+
+            for (size_t j = 0; j < group; j++) {
+               slot_indices[j] = reductionfn(hashfn(keys_in[base + j]));
+               prefetch(&keys[slot_indices[j]], 0, 1);
+            }
+
+            for (size_t j = 0; j < group; j++) {
+               if (const auto payload = lookup_from(slot_indices[j], keys_in[base + j])) {
+                  out[base + j] = payload.value();
+                  found++;
+               }
+            }
+         }
+
+         return found;
+      }
+
+      std::map<std::string, double> lookup_statistics(const std::vector<Key>& dataset) {
+         size_t min_psl = 0, max_psl = 0, total_psl = 0;
+         long double average_psl = 0;
 
-      std::vector<Bucket> buckets;
+         for (const auto& key : dataset) {
+            // Using template functor should successfully inline actual hash computation
+            const auto orig_slot_index = reductionfn(hashfn(key));
+            auto slot_index = orig_slot_index;
+            size_t probing_step = 0;
+
+            for (;;) {
+               auto& bucket = keys[slot_index];
+               for (size_t i = 0; i < BucketSize; i++) {
+                  if (bucket.keys[i] == key) {
+                     average_psl += static_cast<long double>(probing_step);
+                     min_psl = std::min(min_psl, probing_step);
+                     max_psl = std::max(max_psl, probing_step);
+                     total_psl += probing_step;
+                     goto next;
+                  }
+
+                  if (bucket.keys[i] == Sentinel)
+                     goto next;
+               }
+
+               // Slot is full, choose a new slot index based on probing function
+               slot_index = probingfn(orig_slot_index, ++probing_step);
+               if (unlikely(slot_index == orig_slot_index))
+                  goto next;
+            }
+
+         next:
+            continue;
+         }
+
+         average_psl /= static_cast<long double>(dataset.size());
+
+         return {{"min_psl", min_psl}, {"max_psl", max_psl}, {"average_psl", average_psl}, {"total_psl", total_psl}};
+      }
+
+      size_t byte_size() const {
+         return sizeof(*this) + keys.byte_size() + payloads.byte_size();
+      }
+
+      static constexpr forceinline size_t bucket_byte_size() {
+         return sizeof(KeyBucket) + sizeof(PayloadBucket);
+      }
+
+      static forceinline std::string name() {
+         return ProbingFn::name() + "_soa_probing";
+      }
+
+      static forceinline std::string hash_name() {
+         return HashFn::name();
+      }
+
+      static forceinline std::string reducer_name() {
+         return ReductionFn::name();
+      }
+
+      static constexpr forceinline size_t bucket_size() {
+         return BucketSize;
+      }
+
+      static constexpr forceinline size_t directory_address_count(const size_t& capacity) {
+         // power of two directory mode, see requires_pow2_directory
+         if constexpr (requires_pow2_directory<ReductionFn>::value || requires_pow2_directory<ProbingFn>::value)
+            return next_pow2((capacity + BucketSize - 1) / BucketSize);
+         return (capacity + BucketSize - 1) / BucketSize;
+      }
+
+      /**
+       * Clears all keys from the hashtable. Note that payloads are technically
+       * still in memory (i.e., might leak if sensitive).
+       */
+      void clear() {
+         for (auto& bucket : keys)
+            bucket.keys.fill(Sentinel);
+      }
+
+      ~SoAProbing() {
+         clear();
+      }
+
+     protected:
+      /**
+       * Resolves a lookup starting from an already computed initial slot
+       * index, following the probing sequence until the key or an empty slot
+       * is found. Only dereferences the payload array on a confirmed match.
+       */
+      forceinline std::optional<Payload> lookup_from(const size_t& orig_slot_index, const Key& key) const {
+         auto slot_index = orig_slot_index;
+         size_t probing_step = 0;
+
+         for (;;) {
+            const auto& bucket = keys[slot_index];
+            for (size_t i = 0; i < BucketSize; i++) {
+               if (bucket.keys[i] == key)
+                  return std::make_optional(payloads[slot_index].payloads[i]);
+
+               if (bucket.keys[i] == Sentinel)
+                  return std::nullopt;
+            }
+
+            // Slot is full, choose a new slot index based on probing function
+            slot_index = probingfn(orig_slot_index, ++probing_step);
+            if (unlikely(slot_index == orig_slot_index))
+               return std::nullopt;
+         }
+      }
+
+      Directory<KeyBucket> keys;
+      Directory<PayloadBucket> payloads;
+   };
+
+   /**
+    * Linear probing table with swiss table style control bytes: a separate
+    * metadata array stores one byte per slot, either a 7 bit hash
+    * fingerprint (high bit clear) or an empty/tombstone marker (high bit
+    * set). Probing tests an entire group of 16 candidate slots with a single
+    * SSE2 compare against the fingerprint and only touches the full slot
+    * array on a fingerprint hit, i.e., long probe runs at high load factors
+    * scan with a fraction of the cache traffic of full key comparisons.
+    *
+    * Probing is linear over aligned groups (no ProbingFn parameter); the
+    * reduction function maps hashes to group indices. Deletions mark the
+    * control byte as tombstone, which probes skip and inserts reuse.
+    */
+   template<class Key, class Payload, class HashFn, class ReductionFn, size_t MaxProbedGroups = 500>
+   struct SwissProbing {
+     public:
+      using KeyType = Key;
+      using PayloadType = Payload;
+
+     protected:
+      /// slots tested per control byte compare
+      static constexpr size_t GroupSize = 16;
+
+      static constexpr std::uint8_t CtrlEmpty = 0x80;
+      static constexpr std::uint8_t CtrlTombstone = 0x81;
+
+      struct Slot {
+         Key key;
+         Payload payload;
+      };
+
+     private:
+      const HashFn hashfn;
+      const ReductionFn reductionfn;
+      const size_t capacity;
+
+      /// one control byte per slot, group contiguous
+      std::vector<std::uint8_t> ctrl;
+      std::vector<Slot> slots;
+
+      static forceinline std::uint8_t fingerprint(const Key& key) {
+         // independent murmur finalizer remix of the key: the hash function
+         // output is typically already reduced to a group index (see the
+         // benchmark registrations), i.e., none of its bits may be reused.
+         // High bit clear to distinguish from the empty/tombstone markers
+         size_t remixed = static_cast<size_t>(key);
+         remixed ^= remixed >> 33;
+         remixed *= 0xff51afd7ed558ccdLLU;
+         remixed ^= remixed >> 33;
+         return remixed & 0x7F;
+      }
+
+      forceinline size_t group_count() const {
+         return ctrl.size() / GroupSize;
+      }
+
+      /// bitmask of the group's slots whose control byte equals byte
+      forceinline unsigned match_group(const size_t& group, const std::uint8_t byte) const {
+#ifdef __SSE2__
+         const __m128i vbyte = _mm_set1_epi8(static_cast<char>(byte));
+         const __m128i vctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&ctrl[group * GroupSize]));
+         return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(vbyte, vctrl)));
+#else
+         // Scalar fallback for non SSE2 targets
+         unsigned mask = 0;
+         for (size_t i = 0; i < GroupSize; i++)
+            mask |= (ctrl[group * GroupSize + i] == byte) ? (1u << i) : 0;
+         return mask;
+#endif
+      }
+
+     public:
+      explicit SwissProbing(const size_t& capacity, const HashFn hashfn = HashFn())
+         : hashfn(hashfn), reductionfn(ReductionFn(directory_address_count(capacity))), capacity(capacity),
+           ctrl(directory_address_count(capacity) * GroupSize, CtrlEmpty),
+           slots(directory_address_count(capacity) * GroupSize) {}
+
+      SwissProbing(SwissProbing&&) noexcept = default;
+
+      /**
+       * Inserts a key, value/payload pair into the hashtable
+       *
+       * Note: Will throw a runtime error iff all groups along the probe
+       * sequence are full and hold no reusable tombstone.
+       *
+       * @param key
+       * @param payload
+       * @return whether or not the key, payload pair was inserted. Insertion
+       *    will fail iff the same key already exists
+       */
+      bool insert(const Key& key, const Payload payload) {
+         const auto fp = fingerprint(key);
+         const auto orig_group = reductionfn(hashfn(key));
+         auto group = orig_group;
+
+         // first tombstone slot along the probe path (reusable once the key
+         // is confirmed absent)
+         size_t free_slot = std::numeric_limits<size_t>::max();
+
+         for (size_t probed = 0;; probed++) {
+            if (unlikely(probed > MaxProbedGroups)) {
+               // place into a tombstone seen along the probe path before
+               // giving up, mirroring Probing::insert: under churn, probe
+               // windows may hold tombstones but no empties
+               if (free_slot != std::numeric_limits<size_t>::max()) {
+                  ctrl[free_slot] = fp;
+                  slots[free_slot] = {.key = key, .payload = payload};
+                  return true;
+               }
+               throw std::runtime_error("Maximum probed group count (" + std::to_string(MaxProbedGroups) +
+                                        ") exceeded");
+            }
+
+            // fingerprint hits: verify the full key (rare false positives)
+            for (auto match = match_group(group, fp); match != 0; match &= match - 1) {
+               const size_t slot_index = group * GroupSize + __builtin_ctz(match);
+               if (slots[slot_index].key == key)
+                  return false; // key already exists
+            }
+
+            if (free_slot == std::numeric_limits<size_t>::max()) {
+               if (const auto tombstones = match_group(group, CtrlTombstone))
+                  free_slot = group * GroupSize + __builtin_ctz(tombstones);
+            }
+
+            // an empty slot proves the key is absent -> place the entry
+            if (const auto empty = match_group(group, CtrlEmpty)) {
+               const size_t slot_index = free_slot != std::numeric_limits<size_t>::max()
+                  ? free_slot
+                  : group * GroupSize + __builtin_ctz(empty);
+               ctrl[slot_index] = fp;
+               slots[slot_index] = {.key = key, .payload = payload};
+               return true;
+            }
+
+            group = (group + 1 == group_count()) ? 0 : group + 1;
+            if (unlikely(group == orig_group)) {
+               if (free_slot != std::numeric_limits<size_t>::max()) {
+                  ctrl[free_slot] = fp;
+                  slots[free_slot] = {.key = key, .payload = payload};
+                  return true;
+               }
+               throw std::runtime_error("Building " + this->name() + " failed: all groups are full");
+            }
+         }
+      }
+
+      /**
+       * Removes a key from the hashtable by marking its control byte as a
+       * tombstone. Probes skip tombstones and inserts reuse them, i.e., no
+       * separate compaction pass is required for correctness.
+       *
+       * @param key
+       * @return whether or not the key was present and removed
+       */
+      bool erase(const Key& key) {
+         const auto fp = fingerprint(key);
+         const auto orig_group = reductionfn(hashfn(key));
+         auto group = orig_group;
+
+         for (size_t probed = 0; probed <= MaxProbedGroups; probed++) {
+            for (auto match = match_group(group, fp); match != 0; match &= match - 1) {
+               const size_t slot_index = group * GroupSize + __builtin_ctz(match);
+               if (slots[slot_index].key == key) {
+                  ctrl[slot_index] = CtrlTombstone;
+                  return true;
+               }
+            }
+
+            if (match_group(group, CtrlEmpty) != 0)
+               return false;
+
+            group = (group + 1 == group_count()) ? 0 : group + 1;
+            if (unlikely(group == orig_group))
+               return false;
+         }
+
+         return false;
+      }
+
+      /**
+       * Retrieves the associated payload/value for a given key.
+       *
+       * @param key
+       * @return the payload or std::nullopt if key was not found in the Hashtable
+       */
+      std::optional<Payload> lookup(const Key& key) const {
+         return lookup_from(reductionfn(hashfn(key)), fingerprint(key), key);
+      }
+
+      /**
+       * Retrieves the payloads for a batch of keys at once, overlapping the
+       * cache misses of the individual lookups: all hashes of a group of
+       * keys are computed and their initial control byte groups prefetched
+       * before the first probe sequence is resolved.
+       *
+       * Entries of out corresponding to keys that are not in the hashtable
+       * are left untouched.
+       *
+       * @param keys pointer to the first key of the batch
+       * @param n batch size
+       * @param out result array, n entries
+       * @return amount of keys that were found
+       */
+      size_t lookup_batch(const Key* keys, const size_t n, Payload* out) const {
+         constexpr size_t batch_group = 16;
+         size_t groups[batch_group];
+         std::uint8_t fps[batch_group];
+         size_t found = 0;
+
+         for (size_t base = 0; base < n; base += batch_group) {
+            const size_t group = std::min(batch_group, n - base);
+
+            for (size_t j = 0; j < group; j++) {
+               groups[j] = reductionfn(hashfn(keys[base + j]));
+               fps[j] = fingerprint(keys[base + j]);
+               prefetch(&ctrl[groups[j] * GroupSize], 0, 1);
+            }
+
+            for (size_t j = 0; j < group; j++) {
+               if (const auto payload = lookup_from(groups[j], fps[j], keys[base + j])) {
+                  out[base + j] = payload.value();
+                  found++;
+               }
+            }
+         }
+
+         return found;
+      }
+
+      std::map<std::string, double> lookup_statistics(const std::vector<Key>& dataset) {
+         size_t min_psl = 0, max_psl = 0, total_psl = 0;
+         long double average_psl = 0;
+
+         for (const auto& key : dataset) {
+            const auto fp = fingerprint(key);
+            const auto orig_group = reductionfn(hashfn(key));
+            auto group = orig_group;
+
+            // probed groups until the key is found (analogous to the psl
+            // counters of the other probing tables)
+            for (size_t probed = 0; probed <= MaxProbedGroups; probed++) {
+               bool done = false;
+               for (auto match = match_group(group, fp); match != 0; match &= match - 1) {
+                  const size_t slot_index = group * GroupSize + __builtin_ctz(match);
+                  if (slots[slot_index].key == key) {
+                     min_psl = std::min(min_psl, probed);
+                     max_psl = std::max(max_psl, probed);
+                     total_psl += probed;
+                     average_psl += static_cast<long double>(probed);
+                     done = true;
+                     break;
+                  }
+               }
+
+               if (done || match_group(group, CtrlEmpty) != 0)
+                  break;
+
+               group = (group + 1 == group_count()) ? 0 : group + 1;
+               if (unlikely(group == orig_group))
+                  break;
+            }
+         }
+
+         average_psl /= static_cast<long double>(dataset.size());
+
+         return {{"min_psl", min_psl}, {"max_psl", max_psl}, {"average_psl", average_psl}, {"total_psl", total_psl}};
+      }
+
+      size_t byte_size() const {
+         return sizeof(*this) + ctrl.size() * sizeof(std::uint8_t) + slots.size() * sizeof(Slot);
+      }
+
+      static constexpr forceinline size_t bucket_byte_size() {
+         return GroupSize * (sizeof(Slot) + sizeof(std::uint8_t));
+      }
+
+      static forceinline std::string name() {
+         return "swiss_probing";
+      }
+
+      static forceinline std::string hash_name() {
+         return HashFn::name();
+      }
+
+      static forceinline std::string reducer_name() {
+         return ReductionFn::name();
+      }
+
+      static constexpr forceinline size_t bucket_size() {
+         return GroupSize;
+      }
+
+      static constexpr forceinline size_t directory_address_count(const size_t& capacity) {
+         // power of two directory mode, see requires_pow2_directory
+         if constexpr (requires_pow2_directory<ReductionFn>::value)
+            return next_pow2((capacity + GroupSize - 1) / GroupSize);
+         return (capacity + GroupSize - 1) / GroupSize;
+      }
+
+      /**
+       * Clears all keys from the hashtable. Note that payloads are technically
+       * still in memory (i.e., might leak if sensitive).
+       */
+      void clear() {
+         std::fill(ctrl.begin(), ctrl.end(), CtrlEmpty);
+      }
+
+     private:
+      /**
+       * Resolves a lookup starting from an already computed group index and
+       * fingerprint. The full slot is only touched on a fingerprint hit; an
+       * empty control byte terminates the probe sequence.
+       */
+      forceinline std::optional<Payload> lookup_from(const size_t& orig_group, const std::uint8_t fp,
+                                                     const Key& key) const {
+         auto group = orig_group;
+
+         for (size_t probed = 0; probed <= MaxProbedGroups; probed++) {
+            for (auto match = match_group(group, fp); match != 0; match &= match - 1) {
+               const size_t slot_index = group * GroupSize + __builtin_ctz(match);
+               if (likely(slots[slot_index].key == key))
+                  return std::make_optional(slots[slot_index].payload);
+            }
+
+            if (match_group(group, CtrlEmpty) != 0)
+               return std::nullopt;
+
+            group = (group + 1 == group_count()) ? 0 : group + 1;
+            if (unlikely(group == orig_group))
+               return std::nullopt;
+         }
+
+         return std::nullopt;
+      }
    };
 } // namespace hashtable
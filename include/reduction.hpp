@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "convenience/builtins.hpp"
+
+namespace hashtable {
+   /// rounds n up to the next power of two (next_pow2(0) == 1)
+   constexpr size_t next_pow2(const size_t& n) {
+      size_t p = 1;
+      while (p < n)
+         p <<= 1;
+      return p;
+   }
+
+   /**
+    * Detects ReductionFns and ProbingFns that only work on power of two
+    * directory sizes (see reduction::Bitmask). Tables consult this trait in
+    * directory_address_count() and round their directory up accordingly,
+    * i.e., the power of two mode is selected purely by the functor choice,
+    * at compile time.
+    */
+   template<class Fn, class = void>
+   struct requires_pow2_directory : std::false_type {};
+
+   template<class Fn>
+   struct requires_pow2_directory<Fn, std::void_t<decltype(Fn::pow2_directory)>>
+      : std::bool_constant<Fn::pow2_directory> {};
+
+   namespace reduction {
+      /**
+       * Reduces hashes into [0, n) with a single AND on the low bits,
+       * replacing the multi cycle divide/multiply sequence of modulo based
+       * reductions. Requires n to be a power of two: tables detect this via
+       * requires_pow2_directory and round their directory up, trading up to
+       * 2x memory slack for division free addressing.
+       */
+      template<class T>
+      struct Bitmask {
+         static constexpr bool pow2_directory = true;
+
+         explicit Bitmask(const size_t& n) : mask(n - 1) {
+            if (unlikely((n & (n - 1)) != 0 || n == 0))
+               throw std::runtime_error("Bitmask reduction requires a power of two directory size");
+         }
+
+         static std::string name() {
+            return "bitmask";
+         }
+
+         forceinline T operator()(const T& hash) const {
+            return hash & mask;
+         }
+
+        private:
+         const T mask;
+      };
+   } // namespace reduction
+} // namespace hashtable
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#ifdef __linux__
+   #include <sched.h>
+#endif
+
+#include "convenience/builtins.hpp"
+
+namespace hashtable {
+   namespace sharded_internal {
+      /// CPUs belonging to a NUMA node, parsed from the kernel's sysfs
+      /// cpulist format ("0-7,64-71"). Empty if the node does not exist.
+      inline std::vector<unsigned> node_cpus(const size_t& node) {
+         std::vector<unsigned> cpus;
+         std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+         std::string list;
+         if (!file.is_open() || !std::getline(file, list))
+            return cpus;
+
+         std::stringstream ranges(list);
+         std::string range;
+         while (std::getline(ranges, range, ',')) {
+            const auto dash = range.find('-');
+            const auto first = std::stoul(range.substr(0, dash));
+            const auto last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+            for (auto cpu = first; cpu <= last; cpu++)
+               cpus.push_back(cpu);
+         }
+         return cpus;
+      }
+
+      /// amount of NUMA nodes of this machine, at least 1
+      inline size_t node_count() {
+         size_t nodes = 0;
+         while (!node_cpus(nodes).empty())
+            nodes++;
+         return nodes == 0 ? 1 : nodes;
+      }
+
+      /**
+       * Invokes f on a thread whose affinity is restricted to the given NUMA
+       * node and waits for it to finish. Memory f allocates and touches is
+       * placed on that node by the kernel's first touch policy, i.e., no
+       * libnuma dependency is required. Falls back to invoking f inline on
+       * platforms without sysfs NUMA topology resp. thread affinity.
+       */
+      template<class F>
+      void run_on_node(const size_t& node, F f) {
+#ifdef __linux__
+         const auto cpus = node_cpus(node);
+         if (!cpus.empty()) {
+            std::thread worker([&] {
+               cpu_set_t set;
+               CPU_ZERO(&set);
+               for (const auto& cpu : cpus)
+                  CPU_SET(cpu, &set);
+               sched_setaffinity(0, sizeof(set), &set);
+
+               f();
+            });
+            worker.join();
+            return;
+         }
+#endif
+         f();
+      }
+   } // namespace sharded_internal
+
+   /**
+    * Partitions the key space across ShardCount independent sub tables, each
+    * allocated and initialized on a thread pinned to one NUMA node so its
+    * directory is placed on that node's memory (first touch policy). On
+    * multi socket machines this avoids the remote socket penalty a single
+    * large directory allocated by one thread would pay for roughly half of
+    * all accesses.
+    *
+    * Operations are routed by a cheap multiply-shift partition hash that is
+    * independent of the wrapped table's hash functions, i.e., shards stay
+    * balanced regardless of how the table hashes internally. The wrapper
+    * implements the common insert/lookup/byte_size/name interface and can
+    * therefore be benchmarked resp. deployed wherever the plain tables are.
+    */
+   template<class Table, size_t ShardCount = 2>
+   struct Sharded {
+     public:
+      using KeyType = typename Table::KeyType;
+      using PayloadType = typename Table::PayloadType;
+
+      static_assert((ShardCount & (ShardCount - 1)) == 0 && ShardCount > 0 && ShardCount <= 256,
+                    "ShardCount must be a power of two within [1, 256] (shard routing uses the hash's top byte)");
+
+      explicit Sharded(const size_t& capacity) {
+         const size_t nodes = sharded_internal::node_count();
+         const size_t shard_capacity = (capacity + ShardCount - 1) / ShardCount;
+
+         for (size_t s = 0; s < ShardCount; s++)
+            sharded_internal::run_on_node(s % nodes,
+                                          [&] { shards[s] = std::make_unique<Table>(shard_capacity); });
+      }
+
+      Sharded(Sharded&&) noexcept = default;
+
+      /**
+       * Inserts a key, value/payload pair into the owning shard.
+       *
+       * @param key
+       * @param payload
+       * @return whether or not the key, payload pair was inserted. Insertion
+       *    will fail iff the same key already exists
+       */
+      bool insert(const KeyType& key, const PayloadType& payload) {
+         Table& shard = *shards[shard_of(key)];
+
+         // the cuckoo tables' insert does not report duplicates, check
+         // explicitly so all wrapped tables behave uniformly
+         if constexpr (std::is_same<decltype(shard.insert(key, payload)), bool>::value) {
+            return shard.insert(key, payload);
+         } else {
+            if (shard.lookup(key).has_value())
+               return false;
+            shard.insert(key, payload);
+            return true;
+         }
+      }
+
+      /**
+       * Retrieves the associated payload/value for a given key.
+       *
+       * @param key
+       * @return the payload or std::nullopt if key was not found in the Hashtable
+       */
+      std::optional<PayloadType> lookup(const KeyType& key) const {
+         return shards[shard_of(key)]->lookup(key);
+      }
+
+      size_t byte_size() const {
+         size_t bytes = sizeof(*this);
+         for (const auto& shard : shards)
+            bytes += shard->byte_size();
+         return bytes;
+      }
+
+      static forceinline std::string name() {
+         return "sharded_" + std::to_string(ShardCount) + "_" + Table::name();
+      }
+
+      static forceinline std::string hash_name() {
+         return Table::hash_name();
+      }
+
+      static forceinline std::string reducer_name() {
+         return Table::reducer_name();
+      }
+
+      static constexpr forceinline size_t bucket_size() {
+         return Table::bucket_size();
+      }
+
+      static constexpr forceinline size_t directory_address_count(const size_t& capacity) {
+         return Table::directory_address_count((capacity + ShardCount - 1) / ShardCount) * ShardCount;
+      }
+
+      void clear() {
+         for (auto& shard : shards)
+            shard->clear();
+      }
+
+     private:
+      /// multiply-shift partition hash. Routing by the mix's top byte keeps
+      /// it independent of the reduction the wrapped table applies to the
+      /// low bits of its own hashes
+      static forceinline size_t shard_of(const KeyType& key) {
+         const std::uint64_t mixed = static_cast<std::uint64_t>(key) * 0x9E3779B97F4A7C15LLU;
+         return (mixed >> 56) & (ShardCount - 1);
+      }
+
+      std::array<std::unique_ptr<Table>, ShardCount> shards;
+   };
+} // namespace hashtable
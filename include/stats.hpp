@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+
+namespace hashtable {
+   /**
+    * Statistics policies, selected via the tables' StatsMode template
+    * parameter.
+    *
+    * NoStats (the default) compiles every counter update out of the insert
+    * and erase hot paths; lookup_statistics() falls back to a full table
+    * resp. dataset walk and only reports what such a walk can recover.
+    *
+    * FullStats maintains incremental counters alongside the mutations, so
+    * lookup_statistics() becomes an O(1) read of live telemetry (occupancy,
+    * displacement, kick counts) suitable for production monitoring.
+    */
+   struct NoStats {
+      static constexpr bool enabled = false;
+
+      static std::string name() {
+         return "nostats";
+      }
+   };
+
+   struct FullStats {
+      static constexpr bool enabled = true;
+
+      static std::string name() {
+         return "fullstats";
+      }
+   };
+} // namespace hashtable
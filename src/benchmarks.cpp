@@ -1,10 +1,15 @@
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <limits>
+#include <memory>
 #include <random>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <benchmark/benchmark.h>
@@ -16,6 +21,9 @@
 
 #include "support/convenience.hpp"
 #include "support/datasets.hpp"
+#include "support/latency.hpp"
+#include "support/parallel.hpp"
+#include "support/perf_events.hpp"
 #include "support/probing_set.hpp"
 
 using Key = std::uint64_t;
@@ -34,7 +42,23 @@ const std::vector<std::int64_t> datasets{static_cast<std::underlying_type_t<data
                                          static_cast<std::underlying_type_t<dataset::ID>>(dataset::ID::WIKI)};
 const std::vector<std::int64_t> probe_distributions{
    static_cast<std::underlying_type_t<dataset::ProbingDistribution>>(dataset::ProbingDistribution::UNIFORM),
-   static_cast<std::underlying_type_t<dataset::ProbingDistribution>>(dataset::ProbingDistribution::EXPONENTIAL)};
+   static_cast<std::underlying_type_t<dataset::ProbingDistribution>>(dataset::ProbingDistribution::EXPONENTIAL),
+   static_cast<std::underlying_type_t<dataset::ProbingDistribution>>(dataset::ProbingDistribution::ZIPFIAN)};
+
+/// hot key concentration of the ZIPFIAN probing distribution (YCSB default)
+constexpr double zipf_skew = 0.99;
+
+/// whether table storage is huge page backed, see hashtable::huge_pages
+const std::vector<std::int64_t> huge_page_modes{0, 1};
+
+/// YCSB-style read/insert/erase percentages for BM_mixed, encoded as
+/// read * 10000 + insert * 100 + erase to fit one ArgsProduct dimension
+const std::vector<std::int64_t> mixed_workloads{
+   100 * 10000 + 0 * 100 + 0, // C: read only
+   95 * 10000 + 5 * 100 + 0, // B: read mostly
+   90 * 10000 + 5 * 100 + 5, // production-like: reads with balanced churn
+   50 * 10000 + 25 * 100 + 25 // A: churn heavy
+};
 
 template<class Fn>
 static void BM_items_per_slot(benchmark::State& state) {
@@ -97,28 +121,53 @@ static void BM_items_per_slot(benchmark::State& state) {
                            static_cast<int64_t>(sizeof(typename decltype(dataset)::value_type)));
 }
 
-template<class Hashtable, class HashFn, bool Presorted = true>
+/// engines opt into the parallel build phases of BM_hashtable via
+/// detectable capabilities: a thread safe insert (see
+/// ConcurrentChained::concurrent_inserts) beats a sorted bulk insert sweep
+/// (see Chained::bulk_insert), which beats the scalar insert loop
+template<class Table, class = void>
+struct supports_concurrent_insert : std::false_type {};
+
+template<class Table>
+struct supports_concurrent_insert<Table, std::void_t<decltype(Table::concurrent_inserts)>> : std::true_type {};
+
+template<class Table, class = void>
+struct has_bulk_insert : std::false_type {};
+
+template<class Table>
+struct has_bulk_insert<Table,
+                       std::void_t<decltype(std::declval<Table&>().bulk_insert(
+                          std::declval<const Key*>(), std::declval<const Key*>(), std::declval<const Payload*>()))>>
+   : std::true_type {};
+
+template<class Hashtable, class HashFn, bool Presorted = true, bool Batched = false, bool Interleaved = false,
+         bool LatencySampled = false>
 static void BM_hashtable(benchmark::State& state) {
+   // latency sampling timestamps individual scalar lookups
+   static_assert(!LatencySampled || (!Batched && !Interleaved));
    const auto ds_size = state.range(0);
    const auto ds_id = static_cast<dataset::ID>(state.range(1));
    const double overallocation = static_cast<double>(state.range(2)) / 100.0;
 
+   // process wide toggle, must be set before the table is constructed and
+   // restored afterwards (other benchmarks share the process)
+   hashtable::huge_pages::enabled = state.range(4) != 0;
+
    // load dataset
    auto dataset = dataset::load_cached(ds_id, ds_size);
    if (dataset.empty())
       throw std::runtime_error("benchmark dataset empty");
 
-   // generate random payloads
-   std::vector<Payload> payloads;
-   payloads.reserve(dataset.size());
-   std::random_device rd;
-   std::default_random_engine rng(rd());
-   std::uniform_int_distribution<Payload> dist(std::numeric_limits<Payload>::min(),
-                                               std::numeric_limits<Payload>::max());
-   for (size_t i = 0; i < dataset.size(); i++)
-      payloads.push_back(dist(rng));
-   if (payloads.size() != dataset.size())
-      throw std::runtime_error("O(hno)");
+   // generate random payloads, partitioned across all hardware threads
+   const auto payload_start_time = std::chrono::steady_clock::now();
+   std::vector<Payload> payloads(dataset.size());
+   parallel::generate(payloads.size(), [&](auto& rng, const size_t from, const size_t to) {
+      std::uniform_int_distribution<Payload> dist(std::numeric_limits<Payload>::min(),
+                                                  std::numeric_limits<Payload>::max());
+      for (size_t i = from; i < to; i++)
+         payloads[i] = dist(rng);
+   });
+   const auto payload_end_time = std::chrono::steady_clock::now();
 
    const auto address_space = overallocation * static_cast<double>(dataset.size());
    const auto capacity = Hashtable::directory_address_count(address_space);
@@ -129,7 +178,7 @@ static void BM_hashtable(benchmark::State& state) {
 
    const auto sample_start_time = std::chrono::steady_clock::now();
    std::vector<typename decltype(dataset)::value_type> sorted_ds(dataset.begin(), dataset.end());
-   std::sort(sorted_ds.begin(), sorted_ds.end());
+   parallel::sort(sorted_ds);
    const auto sample_end_time = std::chrono::steady_clock::now();
 
    // create hashtable and insert all keys
@@ -137,38 +186,153 @@ static void BM_hashtable(benchmark::State& state) {
    Hashtable table(address_space, HashFn(sorted_ds.begin(), sorted_ds.end(), capacity));
    bool failed = false;
    size_t failed_at = 0;
-   try {
-      for (size_t i = 0; i < sorted_ds.size(); i++) {
-         const auto& key = sorted_ds[i];
-         const auto& payload = payloads[i];
-         table.insert(key, payload);
-         failed_at++;
-      }
-   } catch (const std::runtime_error& e) { failed = true; }
+   if constexpr (supports_concurrent_insert<Hashtable>::value) {
+      // thread safe insert: partition the sorted keys across all hardware
+      // threads
+      const size_t thread_cnt =
+         std::max(static_cast<size_t>(1), static_cast<size_t>(std::thread::hardware_concurrency()));
+      const size_t chunk = (sorted_ds.size() + thread_cnt - 1) / thread_cnt;
+
+      std::atomic<size_t> inserted(0);
+      std::atomic<bool> insert_failed(false);
+      std::vector<std::thread> threads;
+      for (size_t t = 0; t < thread_cnt; t++)
+         threads.emplace_back([&, t] {
+            const size_t from = t * chunk;
+            const size_t to = std::min(from + chunk, sorted_ds.size());
+            size_t local_inserted = 0;
+            try {
+               for (size_t i = from; i < to; i++) {
+                  table.insert(sorted_ds[i], payloads[i]);
+                  local_inserted++;
+               }
+            } catch (const std::runtime_error& e) { insert_failed = true; }
+            inserted += local_inserted;
+         });
+      for (auto& thread : threads)
+         thread.join();
+
+      failed = insert_failed;
+      failed_at = inserted;
+   } else if constexpr (has_bulk_insert<Hashtable>::value) {
+      // sorted keys sweep the directory sequentially, see Chained::bulk_insert
+      try {
+         failed_at = table.bulk_insert(sorted_ds.begin(), sorted_ds.end(), payloads.begin());
+      } catch (const std::runtime_error& e) { failed = true; }
+   } else {
+      try {
+         for (size_t i = 0; i < sorted_ds.size(); i++) {
+            const auto& key = sorted_ds[i];
+            const auto& payload = payloads[i];
+            table.insert(key, payload);
+            failed_at++;
+         }
+      } catch (const std::runtime_error& e) { failed = true; }
+   }
    const auto ht_build_end = std::chrono::steady_clock::now();
 
    // probe in random order to limit caching effects
    const auto probing_dist = static_cast<dataset::ProbingDistribution>(state.range(3));
-   const auto probing_set = dataset::generate_probing_set(dataset, probing_dist);
+   const auto probing_set = dataset::generate_probing_set(dataset, probing_dist, zipf_skew);
+
+   // microarchitectural attribution for the measurement loop
+   perf::Counters perf_counters;
+   perf_counters.start();
 
    size_t i = 0;
-   for (auto _ : state) {
-      if (failed)
-         continue;
+   constexpr size_t batch_size = 64;
+   latency::Histogram latency_histogram;
+   if constexpr (Interleaved) {
+      std::vector<Payload> batch_out(batch_size);
+      for (auto _ : state) {
+         if (failed)
+            continue;
 
-      while (unlikely(i >= probing_set.size()))
-         i -= probing_set.size();
-      const auto& key = probing_set[i++];
+         if (unlikely(i + batch_size > probing_set.size()))
+            i = 0;
+
+         const auto found = table.lookup_interleaved(&probing_set[i], batch_size, batch_out.data());
+         benchmark::DoNotOptimize(found);
+         benchmark::DoNotOptimize(batch_out.data());
+
+         __sync_synchronize();
+
+         i += batch_size;
+      }
+   } else if constexpr (Batched) {
+      std::vector<Payload> batch_out(batch_size);
+      for (auto _ : state) {
+         if (failed)
+            continue;
+
+         if (unlikely(i + batch_size > probing_set.size()))
+            i = 0;
+
+         const auto found = table.lookup_batch(&probing_set[i], batch_size, batch_out.data());
+         benchmark::DoNotOptimize(found);
+         benchmark::DoNotOptimize(batch_out.data());
+
+         __sync_synchronize();
+
+         i += batch_size;
+      }
+   } else if constexpr (LatencySampled) {
+      // per operation latency tail: timestamping every lookup would dominate
+      // the fast engines, so only every SampleInterval-th lookup is measured
+      // (rdtsc, see support/latency.hpp) and folded into the histogram. All
+      // other lookups run exactly like the scalar loop below
+      constexpr size_t SampleInterval = 64;
+      size_t until_sample = 0;
+      for (auto _ : state) {
+         if (failed)
+            continue;
+
+         while (unlikely(i >= probing_set.size()))
+            i -= probing_set.size();
+         const auto& key = probing_set[i++];
+
+         if (unlikely(until_sample == 0)) {
+            until_sample = SampleInterval;
+            const auto lookup_start = latency::timestamp();
+            const auto payload_opt = table.lookup(key);
+            const auto payload = payload_opt.value();
+            benchmark::DoNotOptimize(payload);
+            latency_histogram.record(latency::timestamp() - lookup_start);
+         } else {
+            const auto payload_opt = table.lookup(key);
+            const auto payload = payload_opt.value();
+            benchmark::DoNotOptimize(payload);
+         }
+         until_sample--;
+
+         __sync_synchronize();
+
+         i++;
+      }
+   } else {
+      for (auto _ : state) {
+         if (failed)
+            continue;
+
+         while (unlikely(i >= probing_set.size()))
+            i -= probing_set.size();
+         const auto& key = probing_set[i++];
 
-      const auto payload_opt = table.lookup(key);
-      const auto payload = payload_opt.value();
-      benchmark::DoNotOptimize(payload);
+         const auto payload_opt = table.lookup(key);
+         const auto payload = payload_opt.value();
+         benchmark::DoNotOptimize(payload);
 
-      __sync_synchronize();
+         __sync_synchronize();
 
-      i++;
+         i++;
+      }
    }
 
+   perf_counters.stop();
+   for (const auto& [event, value] : perf_counters.read())
+      state.counters[event] = value;
+
+   state.counters["payload_time"] = std::chrono::duration<double>(payload_end_time - payload_start_time).count();
    state.counters["sample_time"] = std::chrono::duration<double>(sample_end_time - sample_start_time).count();
    state.counters["build_time"] = std::chrono::duration<double>(ht_build_end - ht_build_start).count();
    state.counters["failed"] = failed ? 1.0 : 0.0;
@@ -178,17 +342,277 @@ static void BM_hashtable(benchmark::State& state) {
    state.counters["table_capacity"] = capacity;
    state.counters["dataset_size"] = static_cast<double>(dataset.size());
    state.counters["hashtable_bytes"] = table.byte_size();
+   state.counters["huge_pages"] = hashtable::huge_pages::enabled ? 1.0 : 0.0;
+   hashtable::huge_pages::enabled = false;
 
    if (!failed) {
       for (const auto& stats : table.lookup_statistics(dataset))
          state.counters[stats.first] = stats.second;
    }
 
+   // tail percentiles in timestamp units (rdtsc ticks on x86), see
+   // support/latency.hpp
+   if constexpr (LatencySampled) {
+      state.counters["lat_samples"] = static_cast<double>(latency_histogram.samples());
+      state.counters["lat_p50"] = latency_histogram.percentile(0.50);
+      state.counters["lat_p90"] = latency_histogram.percentile(0.90);
+      state.counters["lat_p99"] = latency_histogram.percentile(0.99);
+      state.counters["lat_p999"] = latency_histogram.percentile(0.999);
+   }
+
    state.SetLabel(Hashtable::name() + ":" + dataset::name(ds_id) + ":" + dataset::name(probing_dist) + ":" +
-                  std::to_string(Presorted));
+                  std::to_string(Presorted) + (Batched ? ":batched" : "") + (Interleaved ? ":interleaved" : "") +
+                  (LatencySampled ? ":latency" : ""));
+   state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                           static_cast<int64_t>(Batched || Interleaved ? batch_size : 1));
+}
+
+/**
+ * Steady state mixed read/insert/erase throughput (YCSB-style): the table
+ * is preloaded with the first half of the dataset, the second half serves
+ * as the insert pool and erases retire the oldest live key, i.e., mixes
+ * with balanced insert/erase ratios hold the fill level constant during
+ * measurement while chains/probe sequences keep churning.
+ */
+template<class Hashtable, class HashFn>
+static void BM_mixed(benchmark::State& state) {
+   const auto ds_size = state.range(0);
+   const auto ds_id = static_cast<dataset::ID>(state.range(1));
+   const double overallocation = static_cast<double>(state.range(2)) / 100.0;
+
+   // read/insert/erase percentages, see mixed_workloads
+   const auto workload = state.range(3);
+   const size_t read_pct = workload / 10000;
+   const size_t insert_pct = (workload / 100) % 100;
+   assert(read_pct + insert_pct + workload % 100 == 100);
+
+   // load dataset
+   const auto dataset = dataset::load_cached(ds_id, ds_size);
+   if (dataset.empty())
+      throw std::runtime_error("benchmark dataset empty");
+
+   // generate random payloads
+   std::vector<Payload> payloads;
+   payloads.reserve(dataset.size());
+   std::random_device rd;
+   std::default_random_engine rng(rd());
+   std::uniform_int_distribution<Payload> dist(std::numeric_limits<Payload>::min(),
+                                               std::numeric_limits<Payload>::max());
+   for (size_t i = 0; i < dataset.size(); i++)
+      payloads.push_back(dist(rng));
+
+   const auto address_space = overallocation * static_cast<double>(dataset.size());
+   const auto capacity = Hashtable::directory_address_count(address_space);
+
+   std::vector<typename decltype(dataset)::value_type> sorted_ds(dataset.begin(), dataset.end());
+   std::sort(sorted_ds.begin(), sorted_ds.end());
+
+   Hashtable table(address_space, HashFn(sorted_ds.begin(), sorted_ds.end(), capacity));
+
+   // preload: dataset[head, tail) is live, the rest is the insert pool
+   size_t head = 0;
+   size_t tail = dataset.size() / 2;
+   bool failed = false;
+   try {
+      for (size_t i = head; i < tail; i++)
+         table.insert(dataset[i], payloads[i]);
+   } catch (const std::runtime_error& e) { failed = true; }
+
+   // cheap xorshift so operation selection does not dominate measurement
+   std::uint64_t rand_state = 0x2545F4914F6CDD1DLLU;
+   const auto next_rand = [&rand_state]() {
+      rand_state ^= rand_state << 13;
+      rand_state ^= rand_state >> 7;
+      rand_state ^= rand_state << 17;
+      return rand_state;
+   };
+
+   // microarchitectural attribution for the measurement loop
+   perf::Counters perf_counters;
+   perf_counters.start();
+
+   size_t found = 0, inserted = 0, erased = 0;
+   for (auto _ : state) {
+      if (unlikely(failed))
+         continue;
+
+      const size_t op = next_rand() % 100;
+      try {
+         if (op < read_pct) {
+            const auto& key = dataset[head + next_rand() % (tail - head)];
+            const auto payload_opt = table.lookup(key);
+            benchmark::DoNotOptimize(payload_opt);
+            found += payload_opt.has_value() ? 1 : 0;
+         } else if (op < read_pct + insert_pct) {
+            // insert pool exhaustion (possible for mixes with more inserts
+            // than erases) degrades the op to a no-op, visible via the
+            // inserted counter
+            if (likely(tail < dataset.size())) {
+               table.insert(dataset[tail], payloads[tail]);
+               tail++;
+               inserted++;
+            }
+         } else if (likely(head + 1 < tail)) {
+            erased += table.erase(dataset[head++]) ? 1 : 0;
+         }
+      } catch (const std::runtime_error& e) { failed = true; }
+   }
+
+   perf_counters.stop();
+   for (const auto& [event, value] : perf_counters.read())
+      state.counters[event] = value;
+
+   state.counters["failed"] = failed ? 1.0 : 0.0;
+   state.counters["found"] = static_cast<double>(found);
+   state.counters["inserted"] = static_cast<double>(inserted);
+   state.counters["erased"] = static_cast<double>(erased);
+   state.counters["live_keys"] = static_cast<double>(tail - head);
+   state.counters["overallocation"] = overallocation;
+   state.counters["table_capacity"] = capacity;
+   state.counters["dataset_size"] = static_cast<double>(dataset.size());
+
+   state.SetLabel(Hashtable::name() + ":" + dataset::name(ds_id) + ":r" + std::to_string(read_pct) + "i" +
+                  std::to_string(insert_pct) + "e" + std::to_string(workload % 100));
    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
 }
 
+/**
+ * Concurrent lookup throughput against a shared immutable table: thread 0
+ * builds the table and probing set before the other threads are released
+ * from google benchmark's start barrier, then all threads issue lookups
+ * simultaneously. The aggregate items/sec across the thread range exposes
+ * where each engine's scaling knees over into bandwidth saturation.
+ */
+template<class Hashtable, class HashFn>
+static void BM_hashtable_mt(benchmark::State& state) {
+   // shared across this benchmark's threads. Only rebuilt when the
+   // configuration changes, i.e., varying the thread count reuses the table
+   static std::unique_ptr<Hashtable> table;
+   static std::vector<Key> probing_set;
+   static std::vector<std::int64_t> built_args;
+   static bool failed = false;
+
+   if (state.thread_index() == 0) {
+      const std::vector<std::int64_t> args{state.range(0), state.range(1), state.range(2), state.range(3)};
+      if (table == nullptr || built_args != args) {
+         const auto ds_id = static_cast<dataset::ID>(state.range(1));
+         const double overallocation = static_cast<double>(state.range(2)) / 100.0;
+
+         // load dataset
+         const auto dataset = dataset::load_cached(ds_id, state.range(0));
+         if (dataset.empty())
+            throw std::runtime_error("benchmark dataset empty");
+
+         // generate random payloads
+         std::vector<Payload> payloads;
+         payloads.reserve(dataset.size());
+         std::random_device rd;
+         std::default_random_engine rng(rd());
+         std::uniform_int_distribution<Payload> dist(std::numeric_limits<Payload>::min(),
+                                                     std::numeric_limits<Payload>::max());
+         for (size_t i = 0; i < dataset.size(); i++)
+            payloads.push_back(dist(rng));
+
+         const auto address_space = overallocation * static_cast<double>(dataset.size());
+         const auto capacity = Hashtable::directory_address_count(address_space);
+
+         std::vector<typename decltype(dataset)::value_type> sorted_ds(dataset.begin(), dataset.end());
+         std::sort(sorted_ds.begin(), sorted_ds.end());
+
+         table = std::make_unique<Hashtable>(address_space, HashFn(sorted_ds.begin(), sorted_ds.end(), capacity));
+         failed = false;
+         try {
+            for (size_t i = 0; i < sorted_ds.size(); i++)
+               table->insert(sorted_ds[i], payloads[i]);
+         } catch (const std::runtime_error& e) { failed = true; }
+
+         const auto probing_dist = static_cast<dataset::ProbingDistribution>(state.range(3));
+         probing_set = dataset::generate_probing_set(dataset, probing_dist, zipf_skew);
+
+         built_args = args;
+      }
+   }
+
+   // each thread probes its own stride of the shared probing set so the
+   // threads do not trivially share cache lines
+   size_t i = static_cast<size_t>(state.thread_index());
+   const size_t stride = static_cast<size_t>(state.threads());
+   for (auto _ : state) {
+      if (failed)
+         continue;
+
+      while (unlikely(i >= probing_set.size()))
+         i -= probing_set.size();
+      const auto& key = probing_set[i];
+
+      const auto payload_opt = table->lookup(key);
+      benchmark::DoNotOptimize(payload_opt);
+
+      i += stride;
+   }
+
+   if (state.thread_index() == 0) {
+      state.counters["failed"] = failed ? 1.0 : 0.0;
+      state.counters["probing_set_size"] = static_cast<double>(probing_set.size());
+      state.counters["hashtable_bytes"] = static_cast<double>(table->byte_size());
+   }
+
+   state.SetLabel(Hashtable::name() + ":" + dataset::name(static_cast<dataset::ID>(state.range(1))) + ":" +
+                  dataset::name(static_cast<dataset::ProbingDistribution>(state.range(3))) + ":mt");
+   state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+template<class Hashtable, class HashFn, bool Bulk = false>
+static void BM_build(benchmark::State& state) {
+   const auto ds_size = state.range(0);
+   const auto ds_id = static_cast<dataset::ID>(state.range(1));
+   const double overallocation = static_cast<double>(state.range(2)) / 100.0;
+
+   // load dataset
+   auto dataset = dataset::load_cached(ds_id, ds_size);
+   if (dataset.empty())
+      throw std::runtime_error("benchmark dataset empty");
+
+   // generate random payloads
+   std::vector<Payload> payloads;
+   payloads.reserve(dataset.size());
+   std::random_device rd;
+   std::default_random_engine rng(rd());
+   std::uniform_int_distribution<Payload> dist(std::numeric_limits<Payload>::min(),
+                                               std::numeric_limits<Payload>::max());
+   for (size_t i = 0; i < dataset.size(); i++)
+      payloads.push_back(dist(rng));
+
+   const auto address_space = overallocation * static_cast<double>(dataset.size());
+   const auto capacity = Hashtable::directory_address_count(address_space);
+
+   std::vector<typename decltype(dataset)::value_type> sorted_ds(dataset.begin(), dataset.end());
+   std::sort(sorted_ds.begin(), sorted_ds.end());
+
+   size_t inserted = 0;
+   for (auto _ : state) {
+      Hashtable table(address_space, HashFn(sorted_ds.begin(), sorted_ds.end(), capacity));
+
+      if constexpr (Bulk) {
+         inserted = table.bulk_insert(sorted_ds.begin(), sorted_ds.end(), payloads.begin());
+      } else {
+         inserted = 0;
+         for (size_t i = 0; i < sorted_ds.size(); i++)
+            inserted += table.insert(sorted_ds[i], payloads[i]) ? 1 : 0;
+      }
+
+      benchmark::DoNotOptimize(inserted);
+   }
+
+   state.counters["inserted"] = static_cast<double>(inserted);
+   state.counters["overallocation"] = overallocation;
+   state.counters["table_capacity"] = capacity;
+   state.counters["dataset_size"] = static_cast<double>(dataset.size());
+
+   state.SetLabel(Hashtable::name() + ":" + dataset::name(ds_id) + (Bulk ? ":bulk" : ""));
+   state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(sorted_ds.size()));
+}
+
 #define SINGLE_ARG(...) __VA_ARGS__
 
 #define BM_Cuckoo(Hashfn, Kickingfn)                                                        \
@@ -203,29 +627,247 @@ static void BM_hashtable(benchmark::State& state) {
                                         Kickingfn>,                                         \
                       Hashfn,                                                               \
                       false)                                                                \
-      ->ArgsProduct({dataset_sizes, datasets, cuckoo_overallocations, probe_distributions}) \
+      ->ArgsProduct({dataset_sizes, datasets, cuckoo_overallocations, probe_distributions, huge_page_modes}) \
+      ->Iterations(10'000'000);
+
+#define BM_SIMDCuckoo(Hashfn, Kickingfn)                                                    \
+   BENCHMARK_TEMPLATE(BM_hashtable,                                                         \
+                      hashtable::SIMDCuckoo<Key,                                            \
+                                            Payload,                                        \
+                                            4,                                              \
+                                            Hashfn,                                         \
+                                            hashing::XXHash3<Key>,                          \
+                                            hashing::reduction::DoNothing<Key>,             \
+                                            hashing::reduction::FastModulo<Key>,            \
+                                            Kickingfn>,                                     \
+                      Hashfn,                                                               \
+                      false)                                                                \
+      ->ArgsProduct({dataset_sizes, datasets, cuckoo_overallocations, probe_distributions, huge_page_modes}) \
       ->Iterations(10'000'000);
 
-#define BM_Probing(Hashfn, Probingfn)                                                                          \
+#define BM_Probing(Hashfn, Probingfn)                                                                        \
    BENCHMARK_TEMPLATE(BM_hashtable,                                                                            \
                       hashtable::Probing<Key, Payload, Hashfn, hashing::reduction::DoNothing<Key>, Probingfn>, \
                       Hashfn,                                                                                  \
                       false)                                                                                   \
-      ->ArgsProduct({dataset_sizes, datasets, overallocations, probe_distributions})                           \
+      ->ArgsProduct({dataset_sizes, datasets, overallocations, probe_distributions, huge_page_modes})          \
       ->Iterations(10'000'000);                                                                                \
    BENCHMARK_TEMPLATE(                                                                                         \
       BM_hashtable,                                                                                            \
       hashtable::RobinhoodProbing<Key, Payload, Hashfn, hashing::reduction::DoNothing<Key>, Probingfn>,        \
       Hashfn,                                                                                                  \
       false)                                                                                                   \
-      ->ArgsProduct({dataset_sizes, datasets, overallocations, probe_distributions})                           \
+      ->ArgsProduct({dataset_sizes, datasets, overallocations, probe_distributions, huge_page_modes})          \
+      ->Iterations(10'000'000);                                                                                \
+   BENCHMARK_TEMPLATE(                                                                                         \
+      BM_hashtable,                                                                                            \
+      hashtable::SoAProbing<Key, Payload, Hashfn, hashing::reduction::DoNothing<Key>, Probingfn>,              \
+      Hashfn,                                                                                                  \
+      false)                                                                                                   \
+      ->ArgsProduct({dataset_sizes, datasets, overallocations, probe_distributions, huge_page_modes})          \
+      ->Iterations(10'000'000);
+
+// Batched lookup variants (lookup_batch with software prefetching) for direct
+// comparison against the scalar lookup path of the same configurations
+#define BM_Batched(Hashfn)                                                                             \
+   BENCHMARK_TEMPLATE(BM_hashtable,                                                                    \
+                      hashtable::Chained<Key, Payload, 2, Hashfn, hashing::reduction::DoNothing<Key>>, \
+                      Hashfn,                                                                          \
+                      false,                                                                           \
+                      true)                                                                            \
+      ->ArgsProduct({dataset_sizes, datasets, overallocations, probe_distributions, huge_page_modes})  \
+      ->Iterations(200'000);                                                                           \
+   BENCHMARK_TEMPLATE(                                                                                 \
+      BM_hashtable,                                                                                    \
+      hashtable::Probing<Key, Payload, Hashfn, hashing::reduction::DoNothing<Key>,                     \
+                         hashtable::LinearProbingFunc>,                                                \
+      Hashfn,                                                                                          \
+      false,                                                                                           \
+      true)                                                                                            \
+      ->ArgsProduct({dataset_sizes, datasets, overallocations, probe_distributions, huge_page_modes})  \
+      ->Iterations(200'000);                                                                           \
+   BENCHMARK_TEMPLATE(BM_hashtable,                                                                    \
+                      hashtable::Cuckoo<Key,                                                           \
+                                        Payload,                                                       \
+                                        4,                                                             \
+                                        Hashfn,                                                        \
+                                        hashing::XXHash3<Key>,                                         \
+                                        hashing::reduction::DoNothing<Key>,                            \
+                                        hashing::reduction::FastModulo<Key>,                           \
+                                        hashtable::BalancedKicking>,                                   \
+                      Hashfn,                                                                          \
+                      false,                                                                           \
+                      true)                                                                            \
+      ->ArgsProduct({dataset_sizes, datasets, cuckoo_overallocations, probe_distributions, huge_page_modes}) \
+      ->Iterations(200'000);                                                                           \
+   BENCHMARK_TEMPLATE(BM_hashtable,                                                                    \
+                      hashtable::SIMDCuckoo<Key,                                                       \
+                                            Payload,                                                   \
+                                            4,                                                         \
+                                            Hashfn,                                                    \
+                                            hashing::XXHash3<Key>,                                     \
+                                            hashing::reduction::DoNothing<Key>,                        \
+                                            hashing::reduction::FastModulo<Key>,                       \
+                                            hashtable::BalancedKicking>,                               \
+                      Hashfn,                                                                          \
+                      false,                                                                           \
+                      true)                                                                            \
+      ->ArgsProduct({dataset_sizes, datasets, cuckoo_overallocations, probe_distributions, huge_page_modes}) \
+      ->Iterations(200'000);
+
+// AMAC-interleaved lookup variants (lookup_interleaved with software
+// pipelined state machines) for direct comparison against the scalar and
+// batched lookup paths of the same configurations
+#define BM_Interleaved(Hashfn)                                                                         \
+   BENCHMARK_TEMPLATE(BM_hashtable,                                                                    \
+                      hashtable::Chained<Key, Payload, 2, Hashfn, hashing::reduction::DoNothing<Key>>, \
+                      Hashfn,                                                                          \
+                      false,                                                                           \
+                      false,                                                                           \
+                      true)                                                                            \
+      ->ArgsProduct({dataset_sizes, datasets, overallocations, probe_distributions, huge_page_modes})  \
+      ->Iterations(200'000);                                                                           \
+   BENCHMARK_TEMPLATE(                                                                                 \
+      BM_hashtable,                                                                                    \
+      hashtable::Probing<Key, Payload, Hashfn, hashing::reduction::DoNothing<Key>,                     \
+                         hashtable::LinearProbingFunc>,                                                \
+      Hashfn,                                                                                          \
+      false,                                                                                           \
+      false,                                                                                           \
+      true)                                                                                            \
+      ->ArgsProduct({dataset_sizes, datasets, overallocations, probe_distributions, huge_page_modes})  \
+      ->Iterations(200'000);                                                                           \
+   BENCHMARK_TEMPLATE(BM_hashtable,                                                                    \
+                      hashtable::Cuckoo<Key,                                                           \
+                                        Payload,                                                       \
+                                        4,                                                             \
+                                        Hashfn,                                                        \
+                                        hashing::XXHash3<Key>,                                         \
+                                        hashing::reduction::DoNothing<Key>,                            \
+                                        hashing::reduction::FastModulo<Key>,                           \
+                                        hashtable::BalancedKicking>,                                   \
+                      Hashfn,                                                                          \
+                      false,                                                                           \
+                      false,                                                                           \
+                      true)                                                                            \
+      ->ArgsProduct({dataset_sizes, datasets, cuckoo_overallocations, probe_distributions, huge_page_modes}) \
+      ->Iterations(200'000);
+
+// Latency sampled scalar lookup variants (see LatencySampled in
+// BM_hashtable): mean throughput hides pathological chains and probe
+// sequences, the sampled p50/p90/p99/p999 counters do not
+#define BM_Latency(Hashfn)                                                                             \
+   BENCHMARK_TEMPLATE(BM_hashtable,                                                                    \
+                      hashtable::Chained<Key, Payload, 2, Hashfn, hashing::reduction::DoNothing<Key>>, \
+                      Hashfn,                                                                          \
+                      false,                                                                           \
+                      false,                                                                           \
+                      false,                                                                           \
+                      true)                                                                            \
+      ->ArgsProduct({dataset_sizes, datasets, overallocations, probe_distributions, huge_page_modes})  \
+      ->Iterations(10'000'000);                                                                        \
+   BENCHMARK_TEMPLATE(                                                                                 \
+      BM_hashtable,                                                                                    \
+      hashtable::Probing<Key, Payload, Hashfn, hashing::reduction::DoNothing<Key>,                     \
+                         hashtable::LinearProbingFunc>,                                                \
+      Hashfn,                                                                                          \
+      false,                                                                                           \
+      false,                                                                                           \
+      false,                                                                                           \
+      true)                                                                                            \
+      ->ArgsProduct({dataset_sizes, datasets, overallocations, probe_distributions, huge_page_modes})  \
+      ->Iterations(10'000'000);                                                                        \
+   BENCHMARK_TEMPLATE(BM_hashtable,                                                                    \
+                      hashtable::Cuckoo<Key,                                                           \
+                                        Payload,                                                       \
+                                        4,                                                             \
+                                        Hashfn,                                                        \
+                                        hashing::XXHash3<Key>,                                         \
+                                        hashing::reduction::DoNothing<Key>,                            \
+                                        hashing::reduction::FastModulo<Key>,                           \
+                                        hashtable::BalancedKicking>,                                   \
+                      Hashfn,                                                                          \
+                      false,                                                                           \
+                      false,                                                                           \
+                      false,                                                                           \
+                      true)                                                                            \
+      ->ArgsProduct({dataset_sizes, datasets, cuckoo_overallocations, probe_distributions, huge_page_modes}) \
+      ->Iterations(10'000'000);
+
+// Mixed read/insert/erase workloads (see BM_mixed), restricted to the
+// engines that support erase
+#define BM_Mixed(Hashfn)                                                                               \
+   BENCHMARK_TEMPLATE(BM_mixed,                                                                        \
+                      hashtable::Chained<Key, Payload, 2, Hashfn, hashing::reduction::DoNothing<Key>>, \
+                      Hashfn)                                                                          \
+      ->ArgsProduct({dataset_sizes, datasets, overallocations, mixed_workloads})                       \
+      ->Iterations(10'000'000);                                                                        \
+   BENCHMARK_TEMPLATE(                                                                                 \
+      BM_mixed,                                                                                        \
+      hashtable::Probing<Key, Payload, Hashfn, hashing::reduction::DoNothing<Key>,                     \
+                         hashtable::LinearProbingFunc>,                                                \
+      Hashfn)                                                                                          \
+      ->ArgsProduct({dataset_sizes, datasets, overallocations, mixed_workloads})                       \
+      ->Iterations(10'000'000);                                                                        \
+   BENCHMARK_TEMPLATE(                                                                                 \
+      BM_mixed,                                                                                        \
+      hashtable::RobinhoodProbing<Key, Payload, Hashfn, hashing::reduction::DoNothing<Key>,            \
+                                  hashtable::LinearProbingFunc>,                                       \
+      Hashfn)                                                                                          \
+      ->ArgsProduct({dataset_sizes, datasets, overallocations, mixed_workloads})                       \
+      ->Iterations(10'000'000);                                                                        \
+   BENCHMARK_TEMPLATE(BM_mixed,                                                                        \
+                      hashtable::SwissProbing<Key, Payload, Hashfn, hashing::reduction::DoNothing<Key>>, \
+                      Hashfn)                                                                          \
+      ->ArgsProduct({dataset_sizes, datasets, overallocations, mixed_workloads})                       \
+      ->Iterations(10'000'000);
+
+// Concurrent lookup scaling over a shared table (see BM_hashtable_mt). Real
+// time is measured since per-thread CPU time hides bandwidth saturation
+#define BM_Multithreaded(Hashfn)                                                                       \
+   BENCHMARK_TEMPLATE(BM_hashtable_mt,                                                                 \
+                      hashtable::Chained<Key, Payload, 2, Hashfn, hashing::reduction::DoNothing<Key>>, \
+                      Hashfn)                                                                          \
+      ->ArgsProduct({dataset_sizes, datasets, overallocations, probe_distributions})                   \
+      ->ThreadRange(1, 64)                                                                             \
+      ->UseRealTime()                                                                                  \
+      ->Iterations(10'000'000);                                                                        \
+   BENCHMARK_TEMPLATE(                                                                                 \
+      BM_hashtable_mt,                                                                                 \
+      hashtable::Probing<Key, Payload, Hashfn, hashing::reduction::DoNothing<Key>,                     \
+                         hashtable::LinearProbingFunc>,                                                \
+      Hashfn)                                                                                          \
+      ->ArgsProduct({dataset_sizes, datasets, overallocations, probe_distributions})                   \
+      ->ThreadRange(1, 64)                                                                             \
+      ->UseRealTime()                                                                                  \
+      ->Iterations(10'000'000);                                                                        \
+   BENCHMARK_TEMPLATE(BM_hashtable_mt,                                                                 \
+                      hashtable::SIMDCuckoo<Key,                                                       \
+                                            Payload,                                                   \
+                                            4,                                                         \
+                                            Hashfn,                                                    \
+                                            hashing::XXHash3<Key>,                                     \
+                                            hashing::reduction::DoNothing<Key>,                        \
+                                            hashing::reduction::FastModulo<Key>,                       \
+                                            hashtable::BalancedKicking>,                               \
+                      Hashfn)                                                                          \
+      ->ArgsProduct({dataset_sizes, datasets, cuckoo_overallocations, probe_distributions})            \
+      ->ThreadRange(1, 64)                                                                             \
+      ->UseRealTime()                                                                                  \
+      ->Iterations(10'000'000);                                                                        \
+   BENCHMARK_TEMPLATE(BM_hashtable_mt,                                                                 \
+                      hashtable::SwissProbing<Key, Payload, Hashfn, hashing::reduction::DoNothing<Key>>, \
+                      Hashfn)                                                                          \
+      ->ArgsProduct({dataset_sizes, datasets, overallocations, probe_distributions})                   \
+      ->ThreadRange(1, 64)                                                                             \
+      ->UseRealTime()                                                                                  \
       ->Iterations(10'000'000);
 
-#define BM_Build(Hashfn, Sorted)                                                                       \
+#define BM_Build(Hashfn, Bulk)                                                                   \
    BENCHMARK_TEMPLATE(BM_build,                                                                        \
                       hashtable::Chained<Key, Payload, 2, Hashfn, hashing::reduction::DoNothing<Key>>, \
                       Hashfn,                                                                          \
-                      Sorted)                                                                          \
+                      Bulk)                                                                            \
       ->ArgsProduct({dataset_sizes, datasets, overallocations})                                        \
       ->Iterations(1);
 
@@ -234,14 +876,33 @@ static void BM_hashtable(benchmark::State& state) {
                       hashtable::Chained<Key, Payload, 2, Hashfn, hashing::reduction::DoNothing<Key>>, \
                       Hashfn,                                                                          \
                       false)                                                                           \
-      ->ArgsProduct({dataset_sizes, datasets, overallocations, probe_distributions})                   \
+      ->ArgsProduct({dataset_sizes, datasets, overallocations, probe_distributions, huge_page_modes})  \
       ->Iterations(10'000'000);                                                                        \
    BM_Cuckoo(SINGLE_ARG(Hashfn), SINGLE_ARG(hashtable::BalancedKicking));                              \
    BM_Cuckoo(SINGLE_ARG(Hashfn), SINGLE_ARG(hashtable::BiasedKicking<20>));                            \
    BM_Cuckoo(SINGLE_ARG(Hashfn), SINGLE_ARG(hashtable::BiasedKicking<80>));                            \
    BM_Cuckoo(SINGLE_ARG(Hashfn), SINGLE_ARG(hashtable::UnbiasedKicking));                              \
+   BM_Cuckoo(SINGLE_ARG(Hashfn), SINGLE_ARG(hashtable::BFSKicking));                                    \
+   BM_SIMDCuckoo(SINGLE_ARG(Hashfn), SINGLE_ARG(hashtable::BalancedKicking));                          \
+   BM_SIMDCuckoo(SINGLE_ARG(Hashfn), SINGLE_ARG(hashtable::UnbiasedKicking));                          \
+   BM_SIMDCuckoo(SINGLE_ARG(Hashfn), SINGLE_ARG(hashtable::BFSKicking));                                \
    BM_Probing(SINGLE_ARG(Hashfn), SINGLE_ARG(hashtable::LinearProbingFunc));                           \
    BM_Probing(SINGLE_ARG(Hashfn), SINGLE_ARG(hashtable::QuadraticProbingFunc));                        \
+   BM_Probing(SINGLE_ARG(Hashfn), SINGLE_ARG(hashtable::MaskedLinearProbingFunc));                     \
+   BM_Probing(SINGLE_ARG(Hashfn), SINGLE_ARG(hashtable::MaskedQuadraticProbingFunc));                  \
+   BENCHMARK_TEMPLATE(BM_hashtable,                                                                    \
+                      hashtable::SwissProbing<Key, Payload, Hashfn, hashing::reduction::DoNothing<Key>>, \
+                      Hashfn,                                                                          \
+                      false)                                                                           \
+      ->ArgsProduct({dataset_sizes, datasets, overallocations, probe_distributions, huge_page_modes})  \
+      ->Iterations(10'000'000);                                                                        \
+   BM_Batched(SINGLE_ARG(Hashfn));                                                                     \
+   BM_Interleaved(SINGLE_ARG(Hashfn));                                                                 \
+   BM_Latency(SINGLE_ARG(Hashfn));                                                                     \
+   BM_Multithreaded(SINGLE_ARG(Hashfn));                                                               \
+   BM_Mixed(SINGLE_ARG(Hashfn));                                                                       \
+   BM_Build(SINGLE_ARG(Hashfn), false);                                                                \
+   BM_Build(SINGLE_ARG(Hashfn), true);                                                                 \
 //   BENCHMARK_TEMPLATE(BM_items_per_slot, Hashfn)                                                       \
 //      ->ArgsProduct({dataset_sizes, datasets, overallocations})                                        \
 //      ->Iterations(1);                                                                                 \
@@ -0,0 +1,197 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <hashtable.hpp>
+
+/**
+ * Lookup throughput regression gate, wired into test.sh: every engine runs
+ * a pinned amount of lookups over a fixed pseudo random keyset and the
+ * measured throughput is compared against the baseline recorded on this
+ * machine. A drop beyond the tolerance fails the process (exit code 1) so
+ * regressions surface before results are shipped. Missing baseline entries
+ * are recorded automatically on first run; pass --record to re-record all
+ * of them, e.g., after an intentional tradeoff or a hardware change.
+ *
+ * usage: ht_microbench [baseline_file] [--record]
+ */
+
+namespace {
+   using Key = std::uint64_t;
+   using Payload = std::uint64_t;
+
+   constexpr size_t KeyCount = 1'000'000;
+   constexpr size_t LookupCount = 2'000'000;
+
+   /// fraction of the recorded baseline a run may drop to before failing
+   constexpr double Tolerance = 0.9;
+
+   /// Murmur finalizer based hash, local to avoid a dependency on the hashing library
+   struct BenchHashFn {
+      static std::string name() {
+         return "bench_hash";
+      }
+
+      size_t operator()(std::uint64_t key) const {
+         key ^= key >> 33;
+         key *= 0xff51afd7ed558ccdLLU;
+         key ^= key >> 33;
+         key *= 0xc4ceb9fe1a85ec53LLU;
+         key ^= key >> 33;
+         return key;
+      }
+   };
+
+   /// second independent hash for the cuckoo tables
+   struct BenchHashFn2 {
+      static std::string name() {
+         return "bench_hash2";
+      }
+
+      size_t operator()(std::uint64_t key) const {
+         key ^= key >> 33;
+         key *= 0xc4ceb9fe1a85ec53LLU;
+         key ^= key >> 29;
+         key *= 0xff51afd7ed558ccdLLU;
+         key ^= key >> 32;
+         return key;
+      }
+   };
+
+   struct BenchModuloReduction {
+      explicit BenchModuloReduction(const size_t& n) : n(n) {}
+
+      static std::string name() {
+         return "bench_modulo";
+      }
+
+      size_t operator()(const size_t& hash) const {
+         return hash % n;
+      }
+
+     private:
+      size_t n;
+   };
+
+   std::map<std::string, double> load_baseline(const std::string& path) {
+      std::map<std::string, double> baseline;
+      std::ifstream file(path);
+      std::string name;
+      double mlookups = 0;
+      while (file >> name >> mlookups)
+         baseline[name] = mlookups;
+      return baseline;
+   }
+
+   void store_baseline(const std::string& path, const std::map<std::string, double>& baseline) {
+      std::ofstream file(path, std::ios::trunc);
+      for (const auto& [name, mlookups] : baseline)
+         file << name << " " << mlookups << "\n";
+   }
+
+   /// builds the table over the keyset and measures million lookups per
+   /// second. The best of three passes is reported: downward noise from
+   /// scheduling or frequency transitions must not trip the regression gate
+   template<class Table>
+   double measure(const std::vector<Key>& keys, const std::vector<Key>& probes) {
+      Table table(keys.size() + keys.size() / 4);
+      for (const auto& key : keys)
+         table.insert(key, key + 1);
+
+      // warmup pass so first touch page faults are not measured
+      size_t found = 0;
+      for (size_t i = 0; i < probes.size(); i += 16)
+         found += table.lookup(probes[i]).has_value() ? 1 : 0;
+
+      double best_seconds = std::numeric_limits<double>::max();
+      for (size_t pass = 0; pass < 3; pass++) {
+         const auto start = std::chrono::steady_clock::now();
+         for (size_t i = 0; i < LookupCount; i++) {
+            const auto payload = table.lookup(probes[i % probes.size()]);
+            found += payload.has_value() ? 1 : 0;
+         }
+         const auto end = std::chrono::steady_clock::now();
+         best_seconds = std::min(best_seconds, std::chrono::duration<double>(end - start).count());
+      }
+
+      // found depends on every lookup, i.e., the loops cannot be elided
+      if (found == 0)
+         std::cerr << "warning: no lookup found anything" << std::endl;
+
+      return static_cast<double>(LookupCount) / best_seconds / 1e6;
+   }
+} // namespace
+
+int main(int argc, char* argv[]) {
+   std::string baseline_path = ".microbench_baseline";
+   bool record = false;
+   for (int i = 1; i < argc; i++) {
+      const std::string arg(argv[i]);
+      if (arg == "--record")
+         record = true;
+      else
+         baseline_path = arg;
+   }
+
+   // fixed seed: every run measures the identical workload
+   std::mt19937_64 rng(42);
+   std::vector<Key> keys;
+   keys.reserve(KeyCount);
+   for (size_t i = 0; i < KeyCount; i++)
+      keys.push_back(rng() % (std::numeric_limits<Key>::max() - 1));
+
+   // probe in shuffled order to limit caching effects
+   std::vector<Key> probes(keys);
+   std::shuffle(probes.begin(), probes.end(), rng);
+
+   std::map<std::string, double> results;
+   results["chained_2"] =
+      measure<hashtable::Chained<Key, Payload, 2, BenchHashFn, BenchModuloReduction>>(keys, probes);
+   results["probing_linear"] = measure<
+      hashtable::Probing<Key, Payload, BenchHashFn, BenchModuloReduction, hashtable::LinearProbingFunc>>(keys,
+                                                                                                         probes);
+   results["robinhood_linear"] =
+      measure<hashtable::RobinhoodProbing<Key, Payload, BenchHashFn, BenchModuloReduction,
+                                          hashtable::LinearProbingFunc>>(keys, probes);
+   results["swiss_probing"] =
+      measure<hashtable::SwissProbing<Key, Payload, BenchHashFn, BenchModuloReduction>>(keys, probes);
+   results["cuckoo_4_balanced"] =
+      measure<hashtable::Cuckoo<Key, Payload, 4, BenchHashFn, BenchHashFn2, BenchModuloReduction,
+                                BenchModuloReduction, hashtable::BalancedKicking>>(keys, probes);
+
+   auto baseline = load_baseline(baseline_path);
+   bool failed = false;
+   bool recorded = false;
+
+   for (const auto& [name, mlookups] : results) {
+      const auto it = baseline.find(name);
+      if (record || it == baseline.end()) {
+         baseline[name] = mlookups;
+         recorded = true;
+         std::cout << name << ": " << mlookups << " mlookups/s (baseline recorded)" << std::endl;
+         continue;
+      }
+
+      const bool regressed = mlookups < Tolerance * it->second;
+      failed |= regressed;
+      std::cout << name << ": " << mlookups << " mlookups/s (baseline " << it->second << ")"
+                << (regressed ? " REGRESSION" : "") << std::endl;
+   }
+
+   if (recorded)
+      store_baseline(baseline_path, baseline);
+
+   if (failed) {
+      std::cerr << "lookup throughput regressed by more than " << (1.0 - Tolerance) * 100
+                << "% against " << baseline_path << std::endl;
+      return 1;
+   }
+   return 0;
+}
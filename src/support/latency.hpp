@@ -0,0 +1,100 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+   #include <x86intrin.h>
+#else
+   #include <chrono>
+#endif
+
+namespace latency {
+   /**
+    * Cycle granular timestamp for measuring individual operation latencies.
+    * rdtsc is deliberately not serialized (no fences), i.e., a single
+    * reading may be skewed by a few cycles of out of order execution --
+    * irrelevant for the sampled histograms built on top, but cheap enough
+    * to sit inside a measurement loop. Falls back to steady_clock
+    * nanoseconds off x86.
+    */
+   inline std::uint64_t timestamp() {
+#if defined(__x86_64__) || defined(__i386__)
+      return __rdtsc();
+#else
+      return static_cast<std::uint64_t>(
+         std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+#endif
+   }
+
+   /**
+    * HDR style log linear histogram over timestamp deltas: one major bucket
+    * per value magnitude (leading bit position), subdivided into 32 linear
+    * minor buckets, i.e., every recorded value lands in a bucket within
+    * ~3% of its true magnitude while the whole histogram stays a fixed
+    * 16KiB. record() is allocation free so sampling inside measurement
+    * loops does not perturb what it measures.
+    */
+   class Histogram {
+      static constexpr size_t MinorBits = 5;
+      static constexpr size_t MinorCount = 1 << MinorBits;
+
+      std::array<std::uint64_t, 64 * MinorCount> buckets{};
+      std::uint64_t total = 0;
+
+     public:
+      void record(const std::uint64_t value) {
+         buckets[index(value)]++;
+         total++;
+      }
+
+      std::uint64_t samples() const {
+         return total;
+      }
+
+      /**
+       * Value below which the requested fraction of recorded samples falls,
+       * e.g., percentile(0.99) is the p99 latency. Resolution is the bucket
+       * width, reported as the bucket's midpoint.
+       *
+       * @param q quantile in [0, 1]
+       */
+      double percentile(const double q) const {
+         if (total == 0)
+            return 0.0;
+
+         const auto target = static_cast<std::uint64_t>(q * static_cast<double>(total));
+         std::uint64_t cumulative = 0;
+         for (size_t i = 0; i < buckets.size(); i++) {
+            cumulative += buckets[i];
+            if (cumulative > target || cumulative == total)
+               return midpoint(i);
+         }
+
+         return midpoint(buckets.size() - 1);
+      }
+
+     private:
+      static size_t index(const std::uint64_t value) {
+         if (value < MinorCount)
+            return value;
+
+         const size_t log2 = 63 - static_cast<size_t>(__builtin_clzll(value));
+         const size_t major = log2 - MinorBits + 1;
+         const size_t minor = (value >> (log2 - MinorBits)) & (MinorCount - 1);
+         return (major << MinorBits) | minor;
+      }
+
+      static double midpoint(const size_t index) {
+         const size_t major = index >> MinorBits;
+         const size_t minor = index & (MinorCount - 1);
+         if (major == 0)
+            return static_cast<double>(minor);
+
+         const size_t log2 = major + MinorBits - 1;
+         const double bucket_width = static_cast<double>(std::uint64_t(1) << (log2 - MinorBits));
+         return static_cast<double>(std::uint64_t(1) << log2) + (static_cast<double>(minor) + 0.5) * bucket_width;
+      }
+   };
+} // namespace latency
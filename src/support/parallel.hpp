@@ -0,0 +1,89 @@
+#pragma once
+
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace parallel {
+   /**
+    * Fills [0, size) in parallel: the output is split into disjoint
+    * chunks, each generated by its own thread with an independently
+    * seeded engine, i.e., no synchronization on the hot path.
+    * fill(rng, from, to) must write exactly [from, to).
+    */
+   template<class F>
+   void generate(const size_t size, F fill) {
+      const size_t thread_cnt =
+         std::max(static_cast<size_t>(1), static_cast<size_t>(std::thread::hardware_concurrency()));
+      const size_t chunk = (size + thread_cnt - 1) / thread_cnt;
+
+      // seeds drawn upfront so the workers never touch the shared device
+      std::random_device rd;
+      std::vector<std::default_random_engine::result_type> seeds;
+      for (size_t t = 0; t < thread_cnt; t++)
+         seeds.push_back(rd());
+
+      std::vector<std::thread> threads;
+      for (size_t t = 0; t < thread_cnt; t++)
+         threads.emplace_back([&, t] {
+            const size_t from = t * chunk;
+            const size_t to = std::min(from + chunk, size);
+            if (from >= to)
+               return;
+
+            std::default_random_engine rng(seeds[t]);
+            fill(rng, from, to);
+         });
+      for (auto& thread : threads)
+         thread.join();
+   }
+
+   /**
+    * Sorts data using all hardware threads: equally sized chunks are
+    * std::sort-ed concurrently, then neighboring runs are pairwise merged
+    * in parallel until a single sorted run remains, i.e., log2(chunks)
+    * inplace_merge passes over the data.
+    */
+   template<class T>
+   void sort(std::vector<T>& data) {
+      const size_t thread_cnt =
+         std::max(static_cast<size_t>(1), static_cast<size_t>(std::thread::hardware_concurrency()));
+
+      // small inputs do not amortize the thread launches
+      if (thread_cnt == 1 || data.size() < (1LLU << 16)) {
+         std::sort(data.begin(), data.end());
+         return;
+      }
+
+      // power of two chunk count so the merge passes pair up evenly
+      size_t chunk_cnt = 1;
+      while (chunk_cnt * 2 <= thread_cnt)
+         chunk_cnt *= 2;
+      const size_t chunk = (data.size() + chunk_cnt - 1) / chunk_cnt;
+
+      std::vector<std::thread> threads;
+      for (size_t c = 0; c < chunk_cnt; c++)
+         threads.emplace_back([&, c] {
+            const size_t from = c * chunk;
+            const size_t to = std::min(from + chunk, data.size());
+            if (from < to)
+               std::sort(data.begin() + from, data.begin() + to);
+         });
+      for (auto& thread : threads)
+         thread.join();
+      threads.clear();
+
+      for (size_t run = chunk; run < data.size(); run *= 2) {
+         for (size_t from = 0; from + run < data.size(); from += 2 * run) {
+            const size_t mid = from + run;
+            const size_t to = std::min(from + 2 * run, data.size());
+            threads.emplace_back(
+               [&, from, mid, to] { std::inplace_merge(data.begin() + from, data.begin() + mid, data.begin() + to); });
+         }
+         for (auto& thread : threads)
+            thread.join();
+         threads.clear();
+      }
+   }
+} // namespace parallel
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+   #include <linux/perf_event.h>
+   #include <sys/ioctl.h>
+   #include <sys/syscall.h>
+   #include <unistd.h>
+
+   #include <cstring>
+#endif
+
+namespace perf {
+   /**
+    * Thin perf_event_open wrapper sampling the microarchitectural events we
+    * keep arguing about (LLC misses, dTLB misses, branch mispredicts,
+    * cycles) around a benchmark's measurement loop.
+    *
+    * Counters measure the calling thread in user mode only. Events the
+    * kernel refuses to open (unsupported PMU, perf_event_paranoid) are
+    * silently dropped, i.e., on non-Linux systems or restricted machines
+    * read() simply returns fewer entries instead of failing the benchmark.
+    */
+   class Counters {
+     public:
+      Counters() {
+#ifdef __linux__
+         open_event("cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+         open_event("branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+         open_event("llc_misses", PERF_TYPE_HW_CACHE,
+                    PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                       (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+         open_event("dtlb_misses", PERF_TYPE_HW_CACHE,
+                    PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                       (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+#endif
+      }
+
+      Counters(const Counters&) = delete;
+      Counters& operator=(const Counters&) = delete;
+
+      ~Counters() {
+#ifdef __linux__
+         for (auto& event : events)
+            close(event.fd);
+#endif
+      }
+
+      /// resets and enables all counters
+      void start() {
+#ifdef __linux__
+         for (auto& event : events) {
+            ioctl(event.fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(event.fd, PERF_EVENT_IOC_ENABLE, 0);
+         }
+#endif
+      }
+
+      /// disables all counters, freezing their values for read()
+      void stop() {
+#ifdef __linux__
+         for (auto& event : events)
+            ioctl(event.fd, PERF_EVENT_IOC_DISABLE, 0);
+#endif
+      }
+
+      /// event name -> counter value since the last start()
+      std::map<std::string, double> read() const {
+         std::map<std::string, double> result;
+#ifdef __linux__
+         for (const auto& event : events) {
+            std::uint64_t value = 0;
+            if (::read(event.fd, &value, sizeof(value)) == sizeof(value))
+               result[event.name] = static_cast<double>(value);
+         }
+#endif
+         return result;
+      }
+
+     private:
+#ifdef __linux__
+      struct Event {
+         std::string name;
+         int fd;
+      };
+
+      std::vector<Event> events;
+
+      void open_event(const std::string& name, const std::uint32_t type, const std::uint64_t config) {
+         perf_event_attr attr;
+         std::memset(&attr, 0, sizeof(attr));
+         attr.size = sizeof(attr);
+         attr.type = type;
+         attr.config = config;
+         attr.disabled = 1;
+         attr.exclude_kernel = 1;
+         attr.exclude_hv = 1;
+
+         const int fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+         if (fd >= 0)
+            events.push_back({name, fd});
+      }
+#endif
+   };
+} // namespace perf
@@ -1,7 +1,11 @@
 #pragma once
 
 #include <algorithm>
+#include <cmath>
 #include <random>
+#include <vector>
+
+#include "parallel.hpp"
 
 namespace dataset {
    enum class ProbingDistribution
@@ -10,7 +14,11 @@ namespace dataset {
       UNIFORM,
       /// probing skewed according to exponential distribution, i.e.,
       /// some keys are way more likely to be picked than others
-      EXPONENTIAL
+      EXPONENTIAL,
+      /// probing skewed according to a zipfian distribution (YCSB style
+      /// hot key concentration): the k-th hottest key is queried with
+      /// probability proportional to 1/k^skew
+      ZIPFIAN
    };
 
    inline std::string name(ProbingDistribution p_dist) {
@@ -19,43 +27,115 @@ namespace dataset {
             return "uniform";
          case ProbingDistribution::EXPONENTIAL:
             return "exponential";
+         case ProbingDistribution::ZIPFIAN:
+            return "zipfian";
       }
       return "unnamed";
    };
 
+   namespace probing_internal {
+      /**
+       * Generalized harmonic number H_{n,s}, the zipfian normalization
+       * constant. The first ranks are summed exactly, the tail is integral
+       * approximated: evaluating one pow() per rank of a 200M element
+       * dataset would dwarf the sampling itself.
+       */
+      inline double zeta(const size_t n, const double s) {
+         const size_t exact = std::min(n, static_cast<size_t>(10000));
+         double z = 0;
+         for (size_t i = 1; i <= exact; i++)
+            z += std::pow(static_cast<double>(i), -s);
+
+         if (n > exact) {
+            if (s == 1.0)
+               z += std::log(static_cast<double>(n) / static_cast<double>(exact));
+            else
+               z += (std::pow(static_cast<double>(n), 1.0 - s) - std::pow(static_cast<double>(exact), 1.0 - s)) /
+                  (1.0 - s);
+         }
+         return z;
+      }
+
+      /**
+       * Zipfian rank sampler after Gray et al., "Quickly Generating
+       * Billion-Record Synthetic Databases" (the same construction YCSB
+       * uses): O(1) per sample, ranks in [0, n) with rank 0 the hottest.
+       * Shared read-only across the generator threads.
+       */
+      class ZipfianSampler {
+        public:
+         ZipfianSampler(const size_t n, const double skew)
+            : n(n), theta(skew), zetan(zeta(n, skew)),
+              eta((1.0 - std::pow(2.0 / static_cast<double>(n), 1.0 - skew)) / (1.0 - zeta(2, skew) / zetan)),
+              alpha(1.0 / (1.0 - skew)) {}
+
+         template<class RNG>
+         size_t operator()(RNG& rng) const {
+            std::uniform_real_distribution<double> uniform(0.0, 1.0);
+            const double u = uniform(rng);
+            const double uz = u * zetan;
+
+            if (uz < 1.0)
+               return 0;
+            if (uz < 1.0 + std::pow(0.5, theta))
+               return 1;
+
+            const auto rank = static_cast<size_t>(static_cast<double>(n) * std::pow(eta * u - eta + 1.0, alpha));
+            return std::min(rank, n - 1);
+         }
+
+        private:
+         const size_t n;
+         const double theta, zetan, eta, alpha;
+      };
+   } // namespace probing_internal
+
    /**
  * generates a probing order for any dataset dataset, given a desired
  * distribution
  */
    template<class T>
-   static std::vector<T> generate_probing_set(std::vector<T> dataset, ProbingDistribution distribution) {
+   static std::vector<T> generate_probing_set(std::vector<T> dataset, ProbingDistribution distribution,
+                                              const double zipf_skew = 0.99) {
       if (dataset.empty())
          return {};
 
-      std::random_device rd;
-      std::default_random_engine rng(rd());
-
       size_t size = dataset.size();
       std::vector<T> probing_set(size, dataset[0]);
 
+      if (distribution != ProbingDistribution::UNIFORM) {
+         // shuffle to avoid skewed results for sorted data, i.e., when
+         // dataset is sorted, this will always prefer lower keys. This
+         // might make a difference for tries, e.g. when they are left deep
+         // vs right deep!
+         std::random_device rd;
+         std::default_random_engine rng(rd());
+         std::shuffle(dataset.begin(), dataset.end(), rng);
+      }
+
       switch (distribution) {
          case ProbingDistribution::UNIFORM: {
-            std::uniform_int_distribution<> dist(0, dataset.size() - 1);
-            for (size_t i = 0; i < size; i++)
-               probing_set[i] = dataset[dist(rng)];
+            parallel::generate(size, [&](auto& rng, const size_t from, const size_t to) {
+               std::uniform_int_distribution<size_t> dist(0, dataset.size() - 1);
+               for (size_t i = from; i < to; i++)
+                  probing_set[i] = dataset[dist(rng)];
+            });
             break;
          }
          case ProbingDistribution::EXPONENTIAL: {
-            // shuffle to avoid skewed results for sorted data, i.e., when
-            // dataset is sorted, this will always prefer lower keys. This
-            // might make a difference for tries, e.g. when they are left deep
-            // vs right deep!
-            std::shuffle(dataset.begin(), dataset.end(), rng);
-
-            std::exponential_distribution<> dist(10);
-
-            for (size_t i = 0; i < size; i++)
-               probing_set[i] = dataset[(dataset.size() - 1) * std::min(1.0, dist(rng))];
+            parallel::generate(size, [&](auto& rng, const size_t from, const size_t to) {
+               std::exponential_distribution<> dist(10);
+               for (size_t i = from; i < to; i++)
+                  probing_set[i] = dataset[(dataset.size() - 1) * std::min(1.0, dist(rng))];
+            });
+            break;
+         }
+         case ProbingDistribution::ZIPFIAN: {
+            const probing_internal::ZipfianSampler sampler(dataset.size(), zipf_skew);
+            parallel::generate(size, [&](auto& rng, const size_t from, const size_t to) {
+               for (size_t i = from; i < to; i++)
+                  probing_set[i] = dataset[sampler(rng)];
+            });
             break;
          }
       }
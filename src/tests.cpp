@@ -1 +1,6 @@
 #include "tests/chained-tests.hpp"
+#include "tests/cuckoo-tests.hpp"
+#include "tests/growing-tests.hpp"
+#include "tests/oracle-tests.hpp"
+#include "tests/probing-tests.hpp"
+#include "tests/sharded-tests.hpp"
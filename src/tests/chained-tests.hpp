@@ -2,8 +2,386 @@
 
 #include <hashtable.hpp>
 
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
 #include <gtest/gtest.h>
 
+namespace chained_test {
+   /// Murmur finalizer based hash, local to the tests to avoid a dependency on the hashing library
+   struct TestHashFn {
+      static std::string name() {
+         return "test_hash";
+      }
+
+      size_t operator()(std::uint64_t key) const {
+         key ^= key >> 33;
+         key *= 0xff51afd7ed558ccdLLU;
+         key ^= key >> 33;
+         key *= 0xc4ceb9fe1a85ec53LLU;
+         key ^= key >> 33;
+         return key;
+      }
+   };
+
+   struct TestModuloReduction {
+      explicit TestModuloReduction(const size_t& n) : n(n) {}
+
+      static std::string name() {
+         return "test_modulo";
+      }
+
+      size_t operator()(const size_t& hash) const {
+         return hash % n;
+      }
+
+     private:
+      size_t n;
+   };
+
+   using TestChained =
+      hashtable::Chained<std::uint64_t, std::uint64_t, 2, TestHashFn, TestModuloReduction>;
+} // namespace chained_test
+
 TEST(CHAINED, RetainsElements) {
-   EXPECT_EQ(1, 0);
+   using namespace chained_test;
+
+   const size_t size = 10000;
+   std::mt19937_64 rng(42);
+   std::unordered_map<std::uint64_t, std::uint64_t> reference;
+   while (reference.size() < size)
+      reference[rng() % (std::numeric_limits<std::uint64_t>::max() - 1)] = rng();
+
+   // deliberately undersized directory to force long overflow chains
+   TestChained table(size / 10);
+   for (const auto& [key, payload] : reference)
+      table.insert(key, payload);
+
+   for (const auto& [key, payload] : reference) {
+      const auto result = table.lookup(key);
+      ASSERT_TRUE(result.has_value());
+      EXPECT_EQ(result.value(), payload);
+   }
+
+   // keys not in the table must not be found
+   for (size_t i = 0; i < size; i++) {
+      const std::uint64_t key = rng() % (std::numeric_limits<std::uint64_t>::max() - 1);
+      if (reference.find(key) != reference.end())
+         continue;
+      EXPECT_FALSE(table.lookup(key).has_value());
+   }
+}
+
+TEST(CHAINED, InterleavedLookup) {
+   using namespace chained_test;
+
+   const size_t size = 10000;
+   std::mt19937_64 rng(42);
+   std::unordered_map<std::uint64_t, std::uint64_t> reference;
+   while (reference.size() < size)
+      reference[rng() % (std::numeric_limits<std::uint64_t>::max() - 1)] = rng();
+
+   // deliberately undersized directory to force long overflow chains
+   TestChained table(size / 10);
+   for (const auto& [key, payload] : reference)
+      table.insert(key, payload);
+
+   constexpr std::uint64_t untouched = 0xdeadbeefdeadbeefLLU;
+   std::vector<std::uint64_t> keys;
+   std::vector<std::uint64_t> expected;
+   for (const auto& [key, payload] : reference) {
+      keys.push_back(key);
+      expected.push_back(payload);
+   }
+
+   // entries for absent keys must be left untouched
+   size_t misses = 0;
+   while (misses < 100) {
+      const auto key = rng() % (std::numeric_limits<std::uint64_t>::max() - 1);
+      if (reference.find(key) != reference.end())
+         continue;
+      keys.push_back(key);
+      expected.push_back(untouched);
+      misses++;
+   }
+
+   std::vector<std::uint64_t> out(keys.size(), untouched);
+   const auto found = table.lookup_interleaved(keys.data(), keys.size(), out.data());
+   EXPECT_EQ(found, reference.size());
+   for (size_t i = 0; i < keys.size(); i++)
+      EXPECT_EQ(out[i], expected[i]);
+}
+
+TEST(CHAINED, RejectsDuplicateKeys) {
+   using namespace chained_test;
+
+   TestChained table(100);
+   EXPECT_TRUE(table.insert(42, 1));
+   EXPECT_FALSE(table.insert(42, 2));
+
+   const auto result = table.lookup(42);
+   ASSERT_TRUE(result.has_value());
+   EXPECT_EQ(result.value(), 1);
+}
+
+TEST(CHAINED, EraseAndReinsert) {
+   using namespace chained_test;
+
+   const size_t size = 10000;
+   std::mt19937_64 rng(42);
+   std::unordered_map<std::uint64_t, std::uint64_t> reference;
+   while (reference.size() < size)
+      reference[rng() % (std::numeric_limits<std::uint64_t>::max() - 1)] = rng();
+
+   // deliberately undersized directory so erase has to fill holes in long
+   // overflow chains
+   TestChained table(size / 10);
+   for (const auto& [key, payload] : reference)
+      table.insert(key, payload);
+
+   // erase every other key
+   std::vector<std::uint64_t> erased;
+   size_t i = 0;
+   for (auto it = reference.begin(); it != reference.end();) {
+      if (i++ % 2 == 0) {
+         EXPECT_TRUE(table.erase(it->first));
+         erased.push_back(it->first);
+         it = reference.erase(it);
+      } else {
+         ++it;
+      }
+   }
+
+   for (const auto& key : erased) {
+      EXPECT_FALSE(table.lookup(key).has_value());
+      EXPECT_FALSE(table.erase(key));
+   }
+   for (const auto& [key, payload] : reference) {
+      const auto result = table.lookup(key);
+      ASSERT_TRUE(result.has_value());
+      EXPECT_EQ(result.value(), payload);
+   }
+
+   // the holes left behind must be reusable
+   for (const auto& key : erased) {
+      EXPECT_TRUE(table.insert(key, key + 1));
+      reference[key] = key + 1;
+   }
+   for (const auto& [key, payload] : reference) {
+      const auto result = table.lookup(key);
+      ASSERT_TRUE(result.has_value());
+      EXPECT_EQ(result.value(), payload);
+   }
+}
+
+TEST(CHAINED, ClearRecyclesBuckets) {
+   using namespace chained_test;
+
+   const size_t size = 10000;
+   TestChained table(size / 10);
+   size_t first_round_bytes = 0;
+
+   for (size_t round = 0; round < 3; round++) {
+      for (std::uint64_t key = 0; key < size; key++)
+         EXPECT_TRUE(table.insert(key, key + round));
+
+      for (std::uint64_t key = 0; key < size; key++) {
+         const auto result = table.lookup(key);
+         ASSERT_TRUE(result.has_value());
+         EXPECT_EQ(result.value(), key + round);
+      }
+
+      // arena blocks must be reused, not grown, across identical rounds
+      if (round == 0)
+         first_round_bytes = table.byte_size();
+      else
+         EXPECT_EQ(table.byte_size(), first_round_bytes);
+
+      table.clear();
+      EXPECT_FALSE(table.lookup(0).has_value());
+   }
+}
+
+TEST(CHAINED, HugePageBackedRetainsElements) {
+   using namespace chained_test;
+
+   const size_t size = 500000;
+   std::mt19937_64 rng(42);
+   std::unordered_map<std::uint64_t, std::uint64_t> reference;
+   while (reference.size() < size)
+      reference[rng() % (std::numeric_limits<std::uint64_t>::max() - 1)] = rng();
+
+   // undersized directory so the arena allocates huge page backed blocks too
+   hashtable::huge_pages::enabled = true;
+   TestChained table(size / 4);
+   // the toggle only matters during construction
+   hashtable::huge_pages::enabled = false;
+
+   for (const auto& [key, payload] : reference)
+      table.insert(key, payload);
+
+   // slot directory and arena blocks both report their mapped (huge page
+   // rounded) sizes
+   EXPECT_GE(table.byte_size() - sizeof(TestChained), 2 * hashtable::huge_pages::Size);
+   EXPECT_EQ((table.byte_size() - sizeof(TestChained)) % hashtable::huge_pages::Size, 0);
+
+   for (const auto& [key, payload] : reference) {
+      const auto result = table.lookup(key);
+      ASSERT_TRUE(result.has_value());
+      EXPECT_EQ(result.value(), payload);
+   }
+}
+
+TEST(CHAINED, RangeVisitorMatchesVector) {
+   using namespace chained_test;
+
+   /// monotone hash, required for sensible range scans
+   struct TestDivHashFn {
+      static std::string name() {
+         return "test_div";
+      }
+
+      size_t operator()(const std::uint64_t& key) const {
+         return key / 8;
+      }
+   };
+   using TestMonotoneChained =
+      hashtable::Chained<std::uint64_t, std::uint64_t, 2, TestDivHashFn, TestModuloReduction>;
+
+   const size_t size = 10000;
+   const std::uint64_t key_space = 8 * size;
+   std::mt19937_64 rng(42);
+   std::map<std::uint64_t, std::uint64_t> reference;
+   while (reference.size() < size)
+      reference[rng() % key_space] = rng();
+
+   TestMonotoneChained table(size + size / 4);
+   for (const auto& [key, payload] : reference)
+      table.insert(key, payload);
+
+   for (size_t trial = 0; trial < 100; trial++) {
+      auto min = rng() % key_space;
+      auto max = rng() % key_space;
+      if (min > max)
+         std::swap(min, max);
+
+      auto expected = table.lookup_range(min, max);
+
+      // the visitor overload must see exactly the vector overload's
+      // entries, with in-range keys, and count_range must agree
+      std::vector<std::uint64_t> visited;
+      table.lookup_range(min, max, [&](const std::uint64_t& key, const std::uint64_t& payload) {
+         EXPECT_GE(key, min);
+         EXPECT_LE(key, max);
+         EXPECT_EQ(reference.at(key), payload);
+         visited.push_back(payload);
+      });
+      EXPECT_EQ(table.count_range(min, max), expected.size());
+
+      std::sort(visited.begin(), visited.end());
+      std::sort(expected.begin(), expected.end());
+      ASSERT_EQ(visited, expected);
+   }
+}
+
+TEST(CHAINED, FullStatsMatchesWalk) {
+   using namespace chained_test;
+   using TestFullStatsChained =
+      hashtable::Chained<std::uint64_t, std::uint64_t, 2, TestHashFn, TestModuloReduction, hashtable::FullStats>;
+
+   const size_t size = 10000;
+
+   // deliberately undersized directory to force long overflow chains
+   TestChained walk_table(size / 10);
+   TestFullStatsChained stats_table(size / 10);
+   for (std::uint64_t key = 0; key < size; key++) {
+      walk_table.insert(key, key + 1);
+      stats_table.insert(key, key + 1);
+   }
+
+   // the incrementally maintained counters must agree with a full table walk
+   std::vector<std::uint64_t> empty_dataset;
+   const auto walk = walk_table.lookup_statistics(empty_dataset);
+   const auto stats = stats_table.lookup_statistics(empty_dataset);
+   EXPECT_EQ(stats.at("stored"), size);
+   EXPECT_EQ(stats.at("empty_buckets"), walk.at("empty_buckets"));
+   EXPECT_EQ(stats.at("additional_buckets"), walk.at("additional_buckets"));
+   EXPECT_EQ(stats.at("max_chain_length"), walk.at("max_chain_length"));
+
+   // erase must keep stored in sync (max_chain_length is a high water mark)
+   for (std::uint64_t key = 0; key < size; key += 2)
+      EXPECT_TRUE(stats_table.erase(key));
+   EXPECT_EQ(stats_table.lookup_statistics(empty_dataset).at("stored"), size / 2);
+}
+
+TEST(CONCURRENT_CHAINED, ParallelInsertRetainsElements) {
+   using namespace chained_test;
+   using TestConcurrentChained =
+      hashtable::ConcurrentChained<std::uint64_t, std::uint64_t, 2, TestHashFn, TestModuloReduction>;
+
+   const size_t size = 100000;
+   const size_t thread_cnt = 8;
+
+   // deliberately undersized directory to force contended overflow chains
+   TestConcurrentChained table(size / 4);
+
+   std::vector<std::thread> threads;
+   for (size_t t = 0; t < thread_cnt; t++)
+      threads.emplace_back([&, t] {
+         for (std::uint64_t key = t; key < size; key += thread_cnt)
+            table.insert(key, key + 1);
+      });
+   for (auto& thread : threads)
+      thread.join();
+
+   for (std::uint64_t key = 0; key < size; key++) {
+      const auto result = table.lookup(key);
+      ASSERT_TRUE(result.has_value());
+      EXPECT_EQ(result.value(), key + 1);
+   }
+   EXPECT_FALSE(table.lookup(size + 1).has_value());
+}
+
+TEST(CHAINED, BulkInsertMatchesInsert) {
+   using namespace chained_test;
+
+   /// monotone hash, maps 8 consecutive keys to the same slot to force chains
+   struct TestDivHashFn {
+      static std::string name() {
+         return "test_div";
+      }
+
+      size_t operator()(const std::uint64_t& key) const {
+         return key / 8;
+      }
+   };
+   using TestMonotoneChained =
+      hashtable::Chained<std::uint64_t, std::uint64_t, 2, TestDivHashFn, TestModuloReduction>;
+
+   const size_t size = 10000;
+   std::vector<std::uint64_t> keys, payloads;
+   for (std::uint64_t key = 0; key < size; key++) {
+      keys.push_back(key);
+      payloads.push_back(key * 3);
+   }
+
+   TestMonotoneChained bulk_table(size / 4);
+   EXPECT_EQ(bulk_table.bulk_insert(keys.begin(), keys.end(), payloads.begin()), size);
+
+   TestMonotoneChained reference_table(size / 4);
+   for (size_t i = 0; i < size; i++)
+      reference_table.insert(keys[i], payloads[i]);
+
+   for (std::uint64_t key = 0; key < size; key++) {
+      const auto result = bulk_table.lookup(key);
+      ASSERT_TRUE(result.has_value());
+      EXPECT_EQ(result.value(), key * 3);
+      EXPECT_EQ(result.value(), reference_table.lookup(key).value());
+   }
+   EXPECT_FALSE(bulk_table.lookup(size + 1).has_value());
 }
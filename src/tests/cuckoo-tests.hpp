@@ -0,0 +1,235 @@
+#pragma once
+
+#include <hashtable.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace cuckoo_test {
+   /// Murmur finalizer based hash, local to the tests to avoid a dependency on the hashing library
+   struct TestHashFn {
+      static std::string name() {
+         return "test_hash";
+      }
+
+      size_t operator()(std::uint64_t key) const {
+         key ^= key >> 33;
+         key *= 0xff51afd7ed558ccdLLU;
+         key ^= key >> 33;
+         key *= 0xc4ceb9fe1a85ec53LLU;
+         key ^= key >> 33;
+         return key;
+      }
+   };
+
+   /// Second, independent hash for the cuckoo tables
+   struct TestHashFn2 {
+      static std::string name() {
+         return "test_hash2";
+      }
+
+      size_t operator()(std::uint64_t key) const {
+         key ^= key >> 31;
+         key *= 0x7fb5d329728ea185LLU;
+         key ^= key >> 27;
+         key *= 0x81dadef4bc2dd44dLLU;
+         key ^= key >> 33;
+         return key;
+      }
+   };
+
+   struct TestModuloReduction {
+      explicit TestModuloReduction(const size_t& n) : n(n) {}
+
+      static std::string name() {
+         return "test_modulo";
+      }
+
+      size_t operator()(const size_t& hash) const {
+         return hash % n;
+      }
+
+     private:
+      size_t n;
+   };
+
+   /**
+    * Inserts Size pseudo random key/payload pairs into Table and asserts that
+    * every pair can be retrieved and that absent keys are not found.
+    */
+   template<class Table, class Key>
+   void retains_elements(const size_t size, const size_t capacity = 0) {
+      std::mt19937_64 rng(42);
+      std::unordered_map<Key, std::uint64_t> reference;
+      while (reference.size() < size) {
+         const Key key = rng() % (std::numeric_limits<Key>::max() - 1);
+         reference[key] = rng();
+      }
+
+      Table table(capacity > 0 ? capacity : size + size / 4);
+      for (const auto& [key, payload] : reference)
+         table.insert(key, payload);
+
+      for (const auto& [key, payload] : reference) {
+         const auto result = table.lookup(key);
+         ASSERT_TRUE(result.has_value());
+         EXPECT_EQ(result.value(), payload);
+      }
+
+      // keys not in the table must not be found
+      for (size_t i = 0; i < size; i++) {
+         const Key key = rng() % (std::numeric_limits<Key>::max() - 1);
+         if (reference.find(key) != reference.end())
+            continue;
+         EXPECT_FALSE(table.lookup(key).has_value());
+      }
+   }
+} // namespace cuckoo_test
+
+TEST(CUCKOO, RetainsElements) {
+   using namespace cuckoo_test;
+   retains_elements<hashtable::Cuckoo<std::uint64_t, std::uint64_t, 4, TestHashFn, TestHashFn2, TestModuloReduction,
+                                      TestModuloReduction, hashtable::BalancedKicking>,
+                    std::uint64_t>(10000);
+}
+
+TEST(SIMD_CUCKOO, RetainsElementsAVX2Width4) {
+   using namespace cuckoo_test;
+   retains_elements<hashtable::SIMDCuckoo<std::uint64_t, std::uint64_t, 4, TestHashFn, TestHashFn2,
+                                          TestModuloReduction, TestModuloReduction, hashtable::BalancedKicking>,
+                    std::uint64_t>(10000);
+}
+
+TEST(SIMD_CUCKOO, RetainsElementsAVX512Width8) {
+   using namespace cuckoo_test;
+   retains_elements<hashtable::SIMDCuckoo<std::uint64_t, std::uint64_t, 8, TestHashFn, TestHashFn2,
+                                          TestModuloReduction, TestModuloReduction, hashtable::BalancedKicking>,
+                    std::uint64_t>(10000);
+}
+
+TEST(SIMD_CUCKOO, RetainsElements32BitKeys) {
+   using namespace cuckoo_test;
+   retains_elements<hashtable::SIMDCuckoo<std::uint32_t, std::uint64_t, 8, TestHashFn, TestHashFn2,
+                                          TestModuloReduction, TestModuloReduction, hashtable::UnbiasedKicking>,
+                    std::uint32_t>(10000);
+}
+
+TEST(CUCKOO, InterleavedLookup) {
+   using namespace cuckoo_test;
+   using Table = hashtable::Cuckoo<std::uint64_t, std::uint64_t, 4, TestHashFn, TestHashFn2, TestModuloReduction,
+                                   TestModuloReduction, hashtable::BalancedKicking>;
+
+   const size_t size = 10000;
+   std::mt19937_64 rng(42);
+   std::unordered_map<std::uint64_t, std::uint64_t> reference;
+   while (reference.size() < size)
+      reference[rng() % (std::numeric_limits<std::uint64_t>::max() - 1)] = rng();
+
+   Table table(size + size / 4);
+   for (const auto& [key, payload] : reference)
+      table.insert(key, payload);
+
+   constexpr std::uint64_t untouched = 0xdeadbeefdeadbeefLLU;
+   std::vector<std::uint64_t> keys;
+   std::vector<std::uint64_t> expected;
+   for (const auto& [key, payload] : reference) {
+      keys.push_back(key);
+      expected.push_back(payload);
+   }
+
+   // entries for absent keys must be left untouched
+   size_t misses = 0;
+   while (misses < 100) {
+      const auto key = rng() % (std::numeric_limits<std::uint64_t>::max() - 1);
+      if (reference.find(key) != reference.end())
+         continue;
+      keys.push_back(key);
+      expected.push_back(untouched);
+      misses++;
+   }
+
+   std::vector<std::uint64_t> out(keys.size(), untouched);
+   const auto found = table.lookup_interleaved(keys.data(), keys.size(), out.data());
+   EXPECT_EQ(found, reference.size());
+   for (size_t i = 0; i < keys.size(); i++)
+      EXPECT_EQ(out[i], expected[i]);
+}
+
+TEST(CUCKOO, StashAbsorbsInsertOverflow) {
+   using namespace cuckoo_test;
+   // more keys than directory slots: at least the surplus must end up in
+   // the overflow stash, yet every key stays retrievable
+   retains_elements<hashtable::Cuckoo<std::uint64_t, std::uint64_t, 4, TestHashFn, TestHashFn2, TestModuloReduction,
+                                      TestModuloReduction, hashtable::BalancedKicking>,
+                    std::uint64_t>(264, 256);
+}
+
+TEST(SIMD_CUCKOO, StashAbsorbsInsertOverflow) {
+   using namespace cuckoo_test;
+   retains_elements<hashtable::SIMDCuckoo<std::uint64_t, std::uint64_t, 4, TestHashFn, TestHashFn2,
+                                          TestModuloReduction, TestModuloReduction, hashtable::BalancedKicking>,
+                    std::uint64_t>(264, 256);
+}
+
+TEST(CUCKOO, BFSKickingRetainsElements) {
+   using namespace cuckoo_test;
+   retains_elements<hashtable::Cuckoo<std::uint64_t, std::uint64_t, 4, TestHashFn, TestHashFn2, TestModuloReduction,
+                                      TestModuloReduction, hashtable::BFSKicking>,
+                    std::uint64_t>(10000);
+}
+
+TEST(SIMD_CUCKOO, BFSKickingHighLoadFactor) {
+   using namespace cuckoo_test;
+   // 98% load factor, where the random walk strategies routinely exceed
+   // their kick budget
+   retains_elements<hashtable::SIMDCuckoo<std::uint64_t, std::uint64_t, 4, TestHashFn, TestHashFn2,
+                                          TestModuloReduction, TestModuloReduction, hashtable::BFSKicking>,
+                    std::uint64_t>(10000, 10200);
+}
+
+TEST(SIMD_CUCKOO, SnapshotRoundTrip) {
+   using namespace cuckoo_test;
+   using Table = hashtable::SIMDCuckoo<std::uint64_t, std::uint64_t, 4, TestHashFn, TestHashFn2, TestModuloReduction,
+                                       TestModuloReduction, hashtable::BalancedKicking>;
+   const char* snapshot_path = "/tmp/hashtable_simd_cuckoo_snapshot_test";
+
+   const size_t size = 10000;
+   std::mt19937_64 rng(42);
+   std::unordered_map<std::uint64_t, std::uint64_t> reference;
+   while (reference.size() < size)
+      reference[rng() % (std::numeric_limits<std::uint64_t>::max() - 1)] = rng();
+
+   Table table(size + size / 4);
+   for (const auto& [key, payload] : reference)
+      table.insert(key, payload);
+   table.save(snapshot_path);
+
+   // restored table must serve all lookups without a rebuild
+   const Table restored(snapshot_path);
+   for (const auto& [key, payload] : reference) {
+      const auto result = restored.lookup(key);
+      ASSERT_TRUE(result.has_value());
+      EXPECT_EQ(result.value(), payload);
+   }
+
+   std::remove(snapshot_path);
+}
+
+TEST(SIMD_CUCKOO, UpdatesExistingKeys) {
+   using namespace cuckoo_test;
+   hashtable::SIMDCuckoo<std::uint64_t, std::uint64_t, 4, TestHashFn, TestHashFn2, TestModuloReduction,
+                         TestModuloReduction, hashtable::BalancedKicking>
+      table(128);
+
+   table.insert(7, 1);
+   table.insert(7, 2);
+
+   const auto result = table.lookup(7);
+   ASSERT_TRUE(result.has_value());
+   EXPECT_EQ(result.value(), 2);
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <hashtable.hpp>
+
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace growing_test {
+   /// Murmur finalizer based hash, local to the tests to avoid a dependency on the hashing library
+   struct TestHashFn {
+      static std::string name() {
+         return "test_hash";
+      }
+
+      size_t operator()(std::uint64_t key) const {
+         key ^= key >> 33;
+         key *= 0xff51afd7ed558ccdLLU;
+         key ^= key >> 33;
+         key *= 0xc4ceb9fe1a85ec53LLU;
+         key ^= key >> 33;
+         return key;
+      }
+   };
+
+   /// Second, independent hash for the cuckoo tables
+   struct TestHashFn2 {
+      static std::string name() {
+         return "test_hash2";
+      }
+
+      size_t operator()(std::uint64_t key) const {
+         key ^= key >> 31;
+         key *= 0x7fb5d329728ea185LLU;
+         key ^= key >> 27;
+         key *= 0x81dadef4bc2dd44dLLU;
+         key ^= key >> 33;
+         return key;
+      }
+   };
+
+   struct TestModuloReduction {
+      explicit TestModuloReduction(const size_t& n) : n(n) {}
+
+      static std::string name() {
+         return "test_modulo";
+      }
+
+      size_t operator()(const size_t& hash) const {
+         return hash % n;
+      }
+
+     private:
+      size_t n;
+   };
+
+   /**
+    * Starts from a deliberately tiny capacity, inserts size pseudo random
+    * key/payload pairs (forcing several growth cycles), spot checks lookups
+    * while migrations are in flight and verifies every pair afterwards.
+    */
+   template<class Table>
+   void grows_retaining_elements(const size_t size) {
+      std::mt19937_64 rng(42);
+      std::unordered_map<std::uint64_t, std::uint64_t> reference;
+      while (reference.size() < size)
+         reference[rng() % (std::numeric_limits<std::uint64_t>::max() - 1)] = rng();
+
+      const size_t initial_capacity = 64;
+      Table table(initial_capacity);
+
+      std::vector<std::pair<std::uint64_t, std::uint64_t>> inserted;
+      inserted.reserve(size);
+      for (const auto& [key, payload] : reference) {
+         EXPECT_TRUE(table.insert(key, payload));
+         inserted.emplace_back(key, payload);
+
+         // lookups must stay correct while a migration is in flight
+         if (inserted.size() % 97 == 0) {
+            const auto& [old_key, old_payload] = inserted[inserted.size() / 2];
+            const auto result = table.lookup(old_key);
+            ASSERT_TRUE(result.has_value());
+            EXPECT_EQ(result.value(), old_payload);
+         }
+      }
+
+      // duplicate inserts must be rejected in every generation
+      for (size_t i = 0; i < inserted.size(); i += 103)
+         EXPECT_FALSE(table.insert(inserted[i].first, inserted[i].second));
+
+      // drain any pending migration
+      while (table.growing())
+         table.maintain();
+      EXPECT_GT(table.capacity(), initial_capacity);
+
+      for (const auto& [key, payload] : reference) {
+         const auto result = table.lookup(key);
+         ASSERT_TRUE(result.has_value());
+         EXPECT_EQ(result.value(), payload);
+      }
+   }
+} // namespace growing_test
+
+TEST(GROWING, ChainedRetainsElements) {
+   using namespace growing_test;
+   grows_retaining_elements<
+      hashtable::Growing<hashtable::Chained<std::uint64_t, std::uint64_t, 2, TestHashFn, TestModuloReduction>>>(10000);
+}
+
+TEST(GROWING, ProbingRetainsElements) {
+   using namespace growing_test;
+   grows_retaining_elements<hashtable::Growing<hashtable::Probing<std::uint64_t, std::uint64_t, TestHashFn,
+                                                                  TestModuloReduction, hashtable::LinearProbingFunc>>>(
+      10000);
+}
+
+TEST(GROWING, RobinhoodProbingRetainsElements) {
+   using namespace growing_test;
+   grows_retaining_elements<hashtable::Growing<hashtable::RobinhoodProbing<
+      std::uint64_t, std::uint64_t, TestHashFn, TestModuloReduction, hashtable::LinearProbingFunc>>>(10000);
+}
+
+TEST(GROWING, CuckooRetainsElements) {
+   using namespace growing_test;
+   grows_retaining_elements<
+      hashtable::Growing<hashtable::Cuckoo<std::uint64_t, std::uint64_t, 4, TestHashFn, TestHashFn2,
+                                           TestModuloReduction, TestModuloReduction, hashtable::BalancedKicking>>>(
+      10000);
+}
@@ -0,0 +1,320 @@
+#pragma once
+
+#include <hashtable.hpp>
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <gtest/gtest.h>
+
+namespace oracle_test {
+   /// Murmur finalizer based hash, local to the tests to avoid a dependency on the hashing library
+   struct TestHashFn {
+      static std::string name() {
+         return "test_hash";
+      }
+
+      size_t operator()(std::uint64_t key) const {
+         key ^= key >> 33;
+         key *= 0xff51afd7ed558ccdLLU;
+         key ^= key >> 33;
+         key *= 0xc4ceb9fe1a85ec53LLU;
+         key ^= key >> 33;
+         return key;
+      }
+   };
+
+   /// second independent hash for the cuckoo tables
+   struct TestHashFn2 {
+      static std::string name() {
+         return "test_hash2";
+      }
+
+      size_t operator()(std::uint64_t key) const {
+         key ^= key >> 33;
+         key *= 0xc4ceb9fe1a85ec53LLU;
+         key ^= key >> 29;
+         key *= 0xff51afd7ed558ccdLLU;
+         key ^= key >> 32;
+         return key;
+      }
+   };
+
+   /// compile time constant hash, pins every key to one directory slot
+   template<size_t C>
+   struct TestConstHashFn {
+      static std::string name() {
+         return "test_const";
+      }
+
+      size_t operator()(const std::uint64_t&) const {
+         return C;
+      }
+   };
+
+   /// monotone clustered hash, maps 8 consecutive keys to the same slot
+   struct TestDivHashFn {
+      static std::string name() {
+         return "test_div";
+      }
+
+      size_t operator()(const std::uint64_t& key) const {
+         return key / 8;
+      }
+   };
+
+   struct TestModuloReduction {
+      explicit TestModuloReduction(const size_t& n) : n(n) {}
+
+      static std::string name() {
+         return "test_modulo";
+      }
+
+      size_t operator()(const size_t& hash) const {
+         return hash % n;
+      }
+
+     private:
+      size_t n;
+   };
+
+   /**
+    * Randomized mixed operation oracle: replays a pseudo random
+    * insert/lookup/erase trace (40/40/20) over a small key space against
+    * std::unordered_map and cross checks every single result, i.e., also
+    * catches divergence in the reported return values, not just lost
+    * entries. The small key space guarantees plenty of duplicate inserts,
+    * misses and re-inserts into previously erased slots.
+    */
+   template<class Table>
+   void mixed_oracle(const size_t operations, const size_t key_space) {
+      std::mt19937_64 rng(42);
+      std::unordered_map<std::uint64_t, std::uint64_t> reference;
+      Table table(2 * key_space);
+
+      for (size_t op = 0; op < operations; op++) {
+         const std::uint64_t key = rng() % key_space;
+         const auto choice = rng() % 100;
+
+         if (choice < 40) {
+            const std::uint64_t payload = rng();
+            ASSERT_EQ(table.insert(key, payload), reference.emplace(key, payload).second);
+         } else if (choice < 80) {
+            const auto result = table.lookup(key);
+            const auto expected = reference.find(key);
+            ASSERT_EQ(result.has_value(), expected != reference.end());
+            if (result.has_value()) {
+               ASSERT_EQ(result.value(), expected->second);
+            }
+         } else {
+            ASSERT_EQ(table.erase(key), reference.erase(key) > 0);
+         }
+      }
+
+      for (const auto& [key, payload] : reference) {
+         const auto result = table.lookup(key);
+         ASSERT_TRUE(result.has_value());
+         EXPECT_EQ(result.value(), payload);
+      }
+   }
+
+   /**
+    * Insert/lookup oracle for the engines without erase (cuckoo tables
+    * dedupe internally and return void from insert, i.e., only fresh keys
+    * are inserted here).
+    */
+   template<class Table>
+   void insert_lookup_oracle(const size_t operations, const size_t key_space) {
+      std::mt19937_64 rng(42);
+      std::unordered_map<std::uint64_t, std::uint64_t> reference;
+      Table table(2 * key_space);
+
+      for (size_t op = 0; op < operations; op++) {
+         const std::uint64_t key = rng() % key_space;
+
+         if (rng() % 100 < 50) {
+            if (reference.find(key) != reference.end())
+               continue;
+            const std::uint64_t payload = rng();
+            table.insert(key, payload);
+            reference.emplace(key, payload);
+         } else {
+            const auto result = table.lookup(key);
+            const auto expected = reference.find(key);
+            ASSERT_EQ(result.has_value(), expected != reference.end());
+            if (result.has_value()) {
+               ASSERT_EQ(result.value(), expected->second);
+            }
+         }
+      }
+
+      for (const auto& [key, payload] : reference) {
+         const auto result = table.lookup(key);
+         ASSERT_TRUE(result.has_value());
+         EXPECT_EQ(result.value(), payload);
+      }
+   }
+} // namespace oracle_test
+
+TEST(ORACLE, Chained) {
+   using namespace oracle_test;
+   mixed_oracle<hashtable::Chained<std::uint64_t, std::uint64_t, 2, TestHashFn, TestModuloReduction>>(100000, 2048);
+}
+
+TEST(ORACLE, ProbingLinear) {
+   using namespace oracle_test;
+   mixed_oracle<hashtable::Probing<std::uint64_t, std::uint64_t, TestHashFn, TestModuloReduction,
+                                   hashtable::LinearProbingFunc>>(100000, 2048);
+}
+
+TEST(ORACLE, ProbingQuadratic) {
+   using namespace oracle_test;
+   mixed_oracle<hashtable::Probing<std::uint64_t, std::uint64_t, TestHashFn, TestModuloReduction,
+                                   hashtable::QuadraticProbingFunc>>(100000, 2048);
+}
+
+TEST(ORACLE, RobinhoodLinear) {
+   using namespace oracle_test;
+   mixed_oracle<hashtable::RobinhoodProbing<std::uint64_t, std::uint64_t, TestHashFn, TestModuloReduction,
+                                            hashtable::LinearProbingFunc>>(100000, 2048);
+}
+
+TEST(ORACLE, SwissProbing) {
+   using namespace oracle_test;
+   mixed_oracle<hashtable::SwissProbing<std::uint64_t, std::uint64_t, TestHashFn, TestModuloReduction>>(100000, 2048);
+}
+
+TEST(ORACLE, SoAProbing) {
+   using namespace oracle_test;
+   insert_lookup_oracle<hashtable::SoAProbing<std::uint64_t, std::uint64_t, TestHashFn, TestModuloReduction,
+                                              hashtable::LinearProbingFunc>>(100000, 2048);
+}
+
+TEST(ORACLE, CuckooKickingStrategies) {
+   using namespace oracle_test;
+   using hashtable::Cuckoo;
+
+   insert_lookup_oracle<Cuckoo<std::uint64_t, std::uint64_t, 4, TestHashFn, TestHashFn2, TestModuloReduction,
+                               TestModuloReduction, hashtable::BalancedKicking>>(100000, 2048);
+   insert_lookup_oracle<Cuckoo<std::uint64_t, std::uint64_t, 4, TestHashFn, TestHashFn2, TestModuloReduction,
+                               TestModuloReduction, hashtable::BiasedKicking<20>>>(100000, 2048);
+   insert_lookup_oracle<Cuckoo<std::uint64_t, std::uint64_t, 4, TestHashFn, TestHashFn2, TestModuloReduction,
+                               TestModuloReduction, hashtable::BiasedKicking<80>>>(100000, 2048);
+   insert_lookup_oracle<Cuckoo<std::uint64_t, std::uint64_t, 4, TestHashFn, TestHashFn2, TestModuloReduction,
+                               TestModuloReduction, hashtable::UnbiasedKicking>>(100000, 2048);
+   insert_lookup_oracle<Cuckoo<std::uint64_t, std::uint64_t, 4, TestHashFn, TestHashFn2, TestModuloReduction,
+                               TestModuloReduction, hashtable::BFSKicking>>(100000, 2048);
+}
+
+TEST(ORACLE, SIMDCuckooKickingStrategies) {
+   using namespace oracle_test;
+   using hashtable::SIMDCuckoo;
+
+   insert_lookup_oracle<SIMDCuckoo<std::uint64_t, std::uint64_t, 4, TestHashFn, TestHashFn2, TestModuloReduction,
+                                   TestModuloReduction, hashtable::BalancedKicking>>(100000, 2048);
+   insert_lookup_oracle<SIMDCuckoo<std::uint64_t, std::uint64_t, 4, TestHashFn, TestHashFn2, TestModuloReduction,
+                                   TestModuloReduction, hashtable::UnbiasedKicking>>(100000, 2048);
+   insert_lookup_oracle<SIMDCuckoo<std::uint64_t, std::uint64_t, 4, TestHashFn, TestHashFn2, TestModuloReduction,
+                                   TestModuloReduction, hashtable::BFSKicking>>(100000, 2048);
+}
+
+TEST(PROBING_EDGE, WrapAroundAtDirectoryEnd) {
+   using namespace oracle_test;
+   // every key hashes to the last directory slot, i.e., all but the first
+   // probe sequence must wrap around to the directory start
+   using TestWrapProbing = hashtable::Probing<std::uint64_t, std::uint64_t, TestConstHashFn<99>, TestModuloReduction,
+                                              hashtable::LinearProbingFunc>;
+
+   TestWrapProbing table(100);
+   for (std::uint64_t key = 0; key < 20; key++)
+      EXPECT_TRUE(table.insert(key, key + 1));
+
+   for (std::uint64_t key = 0; key < 20; key++) {
+      const auto result = table.lookup(key);
+      ASSERT_TRUE(result.has_value());
+      EXPECT_EQ(result.value(), key + 1);
+   }
+   EXPECT_FALSE(table.lookup(20).has_value());
+}
+
+TEST(PROBING_EDGE, MaxProbingStepsExhaustion) {
+   using namespace oracle_test;
+   // a constant hash funnels every key through the same probe sequence;
+   // with MaxProbingSteps = 4 the sixth insert has no slot within reach
+   using TestBoundedProbing = hashtable::Probing<std::uint64_t, std::uint64_t, TestConstHashFn<0>,
+                                                 TestModuloReduction, hashtable::LinearProbingFunc, 4>;
+
+   TestBoundedProbing table(100);
+   for (std::uint64_t key = 0; key < 5; key++)
+      EXPECT_TRUE(table.insert(key, key + 1));
+   EXPECT_THROW(table.insert(5, 6), std::runtime_error);
+
+   // the failed insert must not have damaged the stored entries
+   for (std::uint64_t key = 0; key < 5; key++) {
+      const auto result = table.lookup(key);
+      ASSERT_TRUE(result.has_value());
+      EXPECT_EQ(result.value(), key + 1);
+   }
+}
+
+TEST(SWISS_EDGE, TombstoneReuseAtProbeLimit) {
+   using namespace oracle_test;
+   // a constant hash funnels every key through the same probe sequence;
+   // with MaxProbedGroups = 2 only the 48 slots of groups 0..2 are in reach
+   using TestBoundedSwiss =
+      hashtable::SwissProbing<std::uint64_t, std::uint64_t, TestConstHashFn<0>, TestModuloReduction, 2>;
+
+   // well over three groups, i.e., the wrap around never terminates a probe
+   TestBoundedSwiss table(16 * 16);
+   const std::uint64_t reachable = 3 * 16;
+   for (std::uint64_t key = 0; key < reachable; key++)
+      EXPECT_TRUE(table.insert(key, key + 1));
+   EXPECT_THROW(table.insert(reachable, 0), std::runtime_error);
+
+   // with every group in reach full, a tombstone along the probe path must
+   // still be reusable
+   EXPECT_TRUE(table.erase(7));
+   EXPECT_TRUE(table.insert(reachable, reachable + 1));
+   EXPECT_FALSE(table.lookup(7).has_value());
+   for (std::uint64_t key = 0; key <= reachable; key++) {
+      if (key == 7)
+         continue;
+      const auto result = table.lookup(key);
+      ASSERT_TRUE(result.has_value());
+      EXPECT_EQ(result.value(), key + 1);
+   }
+}
+
+TEST(ROBINHOOD_EDGE, DisplacementUnderClustering) {
+   using namespace oracle_test;
+   // a monotone clustered hash piles 8 consecutive keys onto each slot, so
+   // robinhood swaps have to spread the clusters across long displacements;
+   // erase then exercises the backward shift within displaced runs
+   using TestClusteredRobinhood = hashtable::RobinhoodProbing<std::uint64_t, std::uint64_t, TestDivHashFn,
+                                                              TestModuloReduction, hashtable::LinearProbingFunc>;
+
+   const size_t size = 1000;
+   TestClusteredRobinhood table(size + size / 4);
+   for (std::uint64_t key = 0; key < size; key++)
+      EXPECT_TRUE(table.insert(key, key + 1));
+
+   std::vector<std::uint64_t> dataset;
+   for (std::uint64_t key = 0; key < size; key++)
+      dataset.push_back(key);
+   EXPECT_GT(table.lookup_statistics(dataset).at("max_psl"), 0);
+
+   for (std::uint64_t key = 0; key < size; key += 2)
+      EXPECT_TRUE(table.erase(key));
+
+   for (std::uint64_t key = 0; key < size; key++) {
+      const auto result = table.lookup(key);
+      if (key % 2 == 0) {
+         EXPECT_FALSE(result.has_value());
+      } else {
+         ASSERT_TRUE(result.has_value());
+         EXPECT_EQ(result.value(), key + 1);
+      }
+   }
+}
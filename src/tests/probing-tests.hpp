@@ -0,0 +1,357 @@
+#pragma once
+
+#include <hashtable.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <unordered_map>
+
+#include <gtest/gtest.h>
+
+namespace probing_test {
+   /// Murmur finalizer based hash, local to the tests to avoid a dependency on the hashing library
+   struct TestHashFn {
+      static std::string name() {
+         return "test_hash";
+      }
+
+      size_t operator()(std::uint64_t key) const {
+         key ^= key >> 33;
+         key *= 0xff51afd7ed558ccdLLU;
+         key ^= key >> 33;
+         key *= 0xc4ceb9fe1a85ec53LLU;
+         key ^= key >> 33;
+         return key;
+      }
+   };
+
+   /// Monotone hash (order preserving) for the range scan tests, mimicking
+   /// the learned models deployed in the benchmarks
+   struct TestDivHashFn {
+      static std::string name() {
+         return "test_div";
+      }
+
+      size_t operator()(const std::uint64_t& key) const {
+         return key / 8;
+      }
+   };
+
+   struct TestModuloReduction {
+      explicit TestModuloReduction(const size_t& n) : n(n) {}
+
+      static std::string name() {
+         return "test_modulo";
+      }
+
+      size_t operator()(const size_t& hash) const {
+         return hash % n;
+      }
+
+     private:
+      size_t n;
+   };
+
+   using TestProbing = hashtable::Probing<std::uint64_t, std::uint64_t, TestHashFn, TestModuloReduction,
+                                          hashtable::LinearProbingFunc>;
+   using TestRobinhood = hashtable::RobinhoodProbing<std::uint64_t, std::uint64_t, TestHashFn, TestModuloReduction,
+                                                     hashtable::LinearProbingFunc>;
+   using TestSoAProbing = hashtable::SoAProbing<std::uint64_t, std::uint64_t, TestHashFn, TestModuloReduction,
+                                                hashtable::LinearProbingFunc>;
+   using TestSwissProbing = hashtable::SwissProbing<std::uint64_t, std::uint64_t, TestHashFn, TestModuloReduction>;
+
+   using TestMonotoneProbing = hashtable::Probing<std::uint64_t, std::uint64_t, TestDivHashFn, TestModuloReduction,
+                                                  hashtable::LinearProbingFunc>;
+   using TestMonotoneRobinhood = hashtable::RobinhoodProbing<std::uint64_t, std::uint64_t, TestDivHashFn,
+                                                             TestModuloReduction, hashtable::LinearProbingFunc>;
+
+   /**
+    * Builds a table over a monotone hash and cross checks lookup_range
+    * against an order preserving reference mapping for random ranges.
+    */
+   template<class Table>
+   void range_scan_matches_reference() {
+      const size_t size = 10000;
+      const std::uint64_t key_space = 8 * size;
+
+      std::mt19937_64 rng(42);
+      std::map<std::uint64_t, std::uint64_t> reference;
+      while (reference.size() < size)
+         reference[rng() % key_space] = rng();
+
+      Table table(size + size / 4);
+      for (const auto& [key, payload] : reference)
+         table.insert(key, payload);
+
+      for (size_t trial = 0; trial < 100; trial++) {
+         auto min = rng() % key_space;
+         auto max = rng() % key_space;
+         if (min > max)
+            std::swap(min, max);
+
+         auto result = table.lookup_range(min, max);
+
+         std::vector<std::uint64_t> expected;
+         for (auto it = reference.lower_bound(min); it != reference.end() && it->first <= max; ++it)
+            expected.push_back(it->second);
+
+         std::sort(result.begin(), result.end());
+         std::sort(expected.begin(), expected.end());
+         ASSERT_EQ(result, expected);
+      }
+   }
+
+   /**
+    * Builds a reference mapping with size pseudo random key/payload pairs and
+    * a matching table with 25% over allocation.
+    */
+   template<class Table>
+   std::pair<Table, std::unordered_map<std::uint64_t, std::uint64_t>> build(const size_t size) {
+      std::mt19937_64 rng(42);
+      std::unordered_map<std::uint64_t, std::uint64_t> reference;
+      while (reference.size() < size)
+         reference[rng() % (std::numeric_limits<std::uint64_t>::max() - 1)] = rng();
+
+      Table table(size + size / 4);
+      for (const auto& [key, payload] : reference)
+         table.insert(key, payload);
+
+      return {std::move(table), std::move(reference)};
+   }
+
+   template<class Table>
+   void expect_contains(const Table& table, const std::unordered_map<std::uint64_t, std::uint64_t>& reference) {
+      for (const auto& [key, payload] : reference) {
+         const auto result = table.lookup(key);
+         ASSERT_TRUE(result.has_value());
+         EXPECT_EQ(result.value(), payload);
+      }
+   }
+   /**
+    * Erases every other key, checks that erased keys are gone while the
+    * remaining ones are untouched and that erased slots are reusable.
+    */
+   template<class Table>
+   void erase_churn(const size_t size) {
+      auto [table, reference] = build<Table>(size);
+
+      std::vector<std::uint64_t> erased;
+      size_t i = 0;
+      for (auto it = reference.begin(); it != reference.end();) {
+         if (i++ % 2 == 0) {
+            EXPECT_TRUE(table.erase(it->first));
+            erased.push_back(it->first);
+            it = reference.erase(it);
+         } else {
+            ++it;
+         }
+      }
+
+      for (const auto& key : erased) {
+         EXPECT_FALSE(table.lookup(key).has_value());
+         EXPECT_FALSE(table.erase(key));
+      }
+      expect_contains(table, reference);
+
+      // erased slots must be reusable
+      for (const auto& key : erased) {
+         EXPECT_TRUE(table.insert(key, key + 1));
+         reference[key] = key + 1;
+      }
+      expect_contains(table, reference);
+   }
+} // namespace probing_test
+
+TEST(PROBING, RetainsElements) {
+   using namespace probing_test;
+   const auto [table, reference] = build<TestProbing>(10000);
+   expect_contains(table, reference);
+}
+
+TEST(ROBINHOOD_PROBING, RetainsElements) {
+   using namespace probing_test;
+   const auto [table, reference] = build<TestRobinhood>(10000);
+   expect_contains(table, reference);
+}
+
+TEST(SOA_PROBING, RetainsElements) {
+   using namespace probing_test;
+   const auto [table, reference] = build<TestSoAProbing>(10000);
+   expect_contains(table, reference);
+
+   // absent keys must not be found
+   std::mt19937_64 rng(1234);
+   for (size_t i = 0; i < 10000; i++) {
+      const auto key = rng() % (std::numeric_limits<std::uint64_t>::max() - 1);
+      if (reference.find(key) == reference.end()) {
+         EXPECT_FALSE(table.lookup(key).has_value());
+      }
+   }
+}
+
+TEST(SWISS_PROBING, RetainsElements) {
+   using namespace probing_test;
+   const auto [table, reference] = build<TestSwissProbing>(10000);
+   expect_contains(table, reference);
+
+   // absent keys must not be found (also exercises fingerprint false
+   // positive verification)
+   std::mt19937_64 rng(1234);
+   for (size_t i = 0; i < 10000; i++) {
+      const auto key = rng() % (std::numeric_limits<std::uint64_t>::max() - 1);
+      if (reference.find(key) == reference.end()) {
+         EXPECT_FALSE(table.lookup(key).has_value());
+      }
+   }
+}
+
+TEST(PROBING, BucketSize4RetainsElements) {
+   using namespace probing_test;
+   // multi slot buckets take the unrolled compare chain in lookup_from
+   // instead of the single slot fast path; churn additionally interleaves
+   // tombstones with the deferred empty check
+   using TestWideProbing = hashtable::Probing<std::uint64_t, std::uint64_t, TestHashFn, TestModuloReduction,
+                                              hashtable::LinearProbingFunc, 500, 4>;
+
+   const auto [table, reference] = build<TestWideProbing>(10000);
+   expect_contains(table, reference);
+   erase_churn<TestWideProbing>(10000);
+}
+
+TEST(PROBING, BitmaskPow2Directory) {
+   using namespace probing_test;
+   using TestBitmaskProbing = hashtable::Probing<std::uint64_t, std::uint64_t, TestHashFn,
+                                                 hashtable::reduction::Bitmask<size_t>,
+                                                 hashtable::MaskedLinearProbingFunc>;
+
+   // the bitmask reduction must round the directory up to a power of two
+   EXPECT_EQ(TestBitmaskProbing::directory_address_count(10000), 16384);
+   EXPECT_EQ(TestProbing::directory_address_count(10000), 10000);
+
+   const auto [table, reference] = build<TestBitmaskProbing>(10000);
+   expect_contains(table, reference);
+}
+
+TEST(PROBING, HugePageBackedRetainsElements) {
+   using namespace probing_test;
+
+   // large enough that the directory spans several huge pages
+   const size_t size = 500000;
+   hashtable::huge_pages::enabled = true;
+   const auto [table, reference] = build<TestProbing>(size);
+   // the toggle only matters during construction
+   hashtable::huge_pages::enabled = false;
+
+   // byte_size must report the mapping, i.e., a huge page multiple
+   EXPECT_GE(table.byte_size() - sizeof(TestProbing), hashtable::huge_pages::Size);
+   EXPECT_EQ((table.byte_size() - sizeof(TestProbing)) % hashtable::huge_pages::Size, 0);
+
+   expect_contains(table, reference);
+}
+
+TEST(QUADRATIC_PROBING, MaskedMatchesLibdivide) {
+   using namespace probing_test;
+   using TestQuadratic = hashtable::Probing<std::uint64_t, std::uint64_t, TestHashFn, TestModuloReduction,
+                                            hashtable::QuadraticProbingFunc>;
+   using TestMaskedQuadratic = hashtable::Probing<std::uint64_t, std::uint64_t, TestHashFn,
+                                                  hashtable::reduction::Bitmask<size_t>,
+                                                  hashtable::MaskedQuadraticProbingFunc>;
+
+   const auto [table, reference] = build<TestQuadratic>(10000);
+   expect_contains(table, reference);
+   const auto [masked_table, masked_reference] = build<TestMaskedQuadratic>(10000);
+   expect_contains(masked_table, masked_reference);
+}
+
+TEST(PROBING, EraseAndReinsert) {
+   using namespace probing_test;
+   // erasing half of all keys crosses the tombstone threshold, i.e., this
+   // also exercises compact()
+   erase_churn<TestProbing>(10000);
+}
+
+TEST(SWISS_PROBING, EraseAndReinsert) {
+   using namespace probing_test;
+   erase_churn<TestSwissProbing>(10000);
+}
+
+TEST(ROBINHOOD_PROBING, EraseAndReinsert) {
+   using namespace probing_test;
+   erase_churn<TestRobinhood>(10000);
+}
+
+TEST(PROBING, InterleavedLookup) {
+   using namespace probing_test;
+   const auto [table, reference] = build<TestProbing>(10000);
+
+   constexpr std::uint64_t untouched = 0xdeadbeefdeadbeefLLU;
+   std::vector<std::uint64_t> keys;
+   std::vector<std::uint64_t> expected;
+   for (const auto& [key, payload] : reference) {
+      keys.push_back(key);
+      expected.push_back(payload);
+   }
+
+   // entries for absent keys must be left untouched
+   std::mt19937_64 rng(1234);
+   size_t misses = 0;
+   while (misses < 100) {
+      const auto key = rng() % (std::numeric_limits<std::uint64_t>::max() - 1);
+      if (reference.find(key) != reference.end())
+         continue;
+      keys.push_back(key);
+      expected.push_back(untouched);
+      misses++;
+   }
+
+   std::vector<std::uint64_t> out(keys.size(), untouched);
+   const auto found = table.lookup_interleaved(keys.data(), keys.size(), out.data());
+   EXPECT_EQ(found, reference.size());
+   for (size_t i = 0; i < keys.size(); i++)
+      EXPECT_EQ(out[i], expected[i]);
+}
+
+TEST(PROBING, LookupRangeMonotone) {
+   using namespace probing_test;
+   range_scan_matches_reference<TestMonotoneProbing>();
+}
+
+TEST(ROBINHOOD_PROBING, LookupRangeMonotone) {
+   using namespace probing_test;
+   range_scan_matches_reference<TestMonotoneRobinhood>();
+}
+
+TEST(PROBING, SnapshotRoundTrip) {
+   using namespace probing_test;
+   const char* snapshot_path = "/tmp/hashtable_probing_snapshot_test";
+
+   const auto [table, reference] = build<TestProbing>(10000);
+   table.save(snapshot_path);
+
+   // restored table must serve all lookups without a rebuild
+   const TestProbing restored(snapshot_path);
+   expect_contains(restored, reference);
+   EXPECT_FALSE(restored.lookup(1).has_value());
+
+   // restoring into an incompatible table type must be rejected
+   ASSERT_THROW(TestRobinhood{snapshot_path}, std::runtime_error);
+
+   std::remove(snapshot_path);
+}
+
+TEST(ROBINHOOD_PROBING, SnapshotRoundTrip) {
+   using namespace probing_test;
+   const char* snapshot_path = "/tmp/hashtable_robinhood_snapshot_test";
+
+   const auto [table, reference] = build<TestRobinhood>(10000);
+   table.save(snapshot_path);
+
+   const TestRobinhood restored(snapshot_path);
+   expect_contains(restored, reference);
+   EXPECT_FALSE(restored.lookup(1).has_value());
+
+   std::remove(snapshot_path);
+}
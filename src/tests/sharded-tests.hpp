@@ -0,0 +1,119 @@
+#pragma once
+
+#include <hashtable.hpp>
+
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+
+#include <gtest/gtest.h>
+
+namespace sharded_test {
+   /// Murmur finalizer based hash, local to the tests to avoid a dependency on the hashing library
+   struct TestHashFn {
+      static std::string name() {
+         return "test_hash";
+      }
+
+      size_t operator()(std::uint64_t key) const {
+         key ^= key >> 33;
+         key *= 0xff51afd7ed558ccdLLU;
+         key ^= key >> 33;
+         key *= 0xc4ceb9fe1a85ec53LLU;
+         key ^= key >> 33;
+         return key;
+      }
+   };
+
+   /// Second, independent hash for the cuckoo tables
+   struct TestHashFn2 {
+      static std::string name() {
+         return "test_hash2";
+      }
+
+      size_t operator()(std::uint64_t key) const {
+         key ^= key >> 31;
+         key *= 0x7fb5d329728ea185LLU;
+         key ^= key >> 27;
+         key *= 0x81dadef4bc2dd44dLLU;
+         key ^= key >> 33;
+         return key;
+      }
+   };
+
+   struct TestModuloReduction {
+      explicit TestModuloReduction(const size_t& n) : n(n) {}
+
+      static std::string name() {
+         return "test_modulo";
+      }
+
+      size_t operator()(const size_t& hash) const {
+         return hash % n;
+      }
+
+     private:
+      size_t n;
+   };
+
+   /**
+    * Inserts size pseudo random key/payload pairs and asserts that every
+    * pair is retrievable from its shard, that duplicates are rejected and
+    * that absent keys are not found.
+    */
+   template<class Table>
+   void shards_retain_elements(const size_t size) {
+      std::mt19937_64 rng(42);
+      std::unordered_map<std::uint64_t, std::uint64_t> reference;
+      while (reference.size() < size)
+         reference[rng() % (std::numeric_limits<std::uint64_t>::max() - 1)] = rng();
+
+      Table table(size + size / 4);
+      for (const auto& [key, payload] : reference)
+         EXPECT_TRUE(table.insert(key, payload));
+
+      // duplicate inserts must be rejected regardless of the owning shard
+      size_t i = 0;
+      for (const auto& [key, payload] : reference) {
+         if (i++ % 103 == 0) {
+            EXPECT_FALSE(table.insert(key, payload));
+         }
+      }
+
+      for (const auto& [key, payload] : reference) {
+         const auto result = table.lookup(key);
+         ASSERT_TRUE(result.has_value());
+         EXPECT_EQ(result.value(), payload);
+      }
+
+      // keys not in the table must not be found
+      for (size_t j = 0; j < size; j++) {
+         const auto key = rng() % (std::numeric_limits<std::uint64_t>::max() - 1);
+         if (reference.find(key) != reference.end())
+            continue;
+         EXPECT_FALSE(table.lookup(key).has_value());
+      }
+   }
+} // namespace sharded_test
+
+TEST(SHARDED, ChainedRetainsElements) {
+   using namespace sharded_test;
+   shards_retain_elements<
+      hashtable::Sharded<hashtable::Chained<std::uint64_t, std::uint64_t, 2, TestHashFn, TestModuloReduction>, 2>>(
+      10000);
+}
+
+TEST(SHARDED, ProbingRetainsElements) {
+   using namespace sharded_test;
+   shards_retain_elements<hashtable::Sharded<
+      hashtable::Probing<std::uint64_t, std::uint64_t, TestHashFn, TestModuloReduction, hashtable::LinearProbingFunc>,
+      4>>(10000);
+}
+
+TEST(SHARDED, CuckooRetainsElements) {
+   using namespace sharded_test;
+   shards_retain_elements<
+      hashtable::Sharded<hashtable::Cuckoo<std::uint64_t, std::uint64_t, 4, TestHashFn, TestHashFn2,
+                                           TestModuloReduction, TestModuloReduction, hashtable::BalancedKicking>,
+                         2>>(10000);
+}
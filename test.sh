@@ -7,3 +7,9 @@ cd "$(dirname "$0")"
 # build and run tests
 ./build.sh ht_tests RELEASE
 cmake-build-release/src/ht_tests
+
+# lookup throughput regression gate: dropping more than 10% below the
+# recorded baseline fails the run. The first run records the baseline;
+# re-record deliberately via `ht_microbench .microbench_baseline --record`
+./build.sh ht_microbench RELEASE
+cmake-build-release/src/ht_microbench .microbench_baseline